@@ -0,0 +1,163 @@
+// Checks the Android crash handler on the host: every case forks a child
+// that installs the handler and then faults, and the parent reads back what
+// the handler wrote and checks the signal, the frames and the mappings.
+//
+// Usage: geode-loader-crash-test [<work dir>]
+// Exits with 1 if any check fails
+
+#include <crashcapture.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    bool s_failed = false;
+
+    void check(bool condition, std::string const& what) {
+        std::fprintf(stderr, "%s: %s\n", condition ? "ok" : "FAILED", what.c_str());
+        if (!condition) s_failed = true;
+    }
+
+    // writeToNull writes here, which is never mapped
+    constexpr uintptr_t FAULT_ADDRESS = 0x10;
+
+    [[gnu::noinline]] void writeToNull() {
+        *reinterpret_cast<int volatile*>(FAULT_ADDRESS) = 1;
+    }
+
+    [[gnu::noinline]] void callAbort() {
+        std::abort();
+    }
+
+    [[gnu::noinline]] void trap() {
+        __builtin_trap();
+    }
+
+    [[gnu::noinline]] int overflowStack(int depth) {
+        int volatile buffer[256];
+        buffer[0] = depth;
+        return overflowStack(depth + 1) + buffer[0];
+    }
+
+    [[gnu::noinline]] void overflow() {
+        overflowStack(0);
+    }
+
+    // an extra frame on top of each fault, so there's a chain to walk
+    [[gnu::noinline]] void faultFrom(void (*fault)()) {
+        fault();
+        // keeps this from being a tail call
+        std::fprintf(stderr, "fault returned\n");
+    }
+
+    std::string getExecutablePath() {
+        char path[PATH_MAX];
+        auto size = readlink("/proc/self/exe", path, sizeof(path) - 1);
+        if (size <= 0) return std::string();
+        return std::string(path, size);
+    }
+
+    struct Case {
+        char const* name;
+        void (*fault)();
+        // any of these is fine, since the signal a trap raises depends on
+        // the architecture
+        std::initializer_list<int> signals;
+        bool checkAddress;
+        // whether the fault happens in our own code. Desktop libc isn't
+        // built with frame pointers, so a fault inside it only has its pc
+        bool checkFrames;
+    };
+
+    void runCase(Case const& test, std::string const& dir) {
+        auto path = dir + "/" + test.name + ".crash";
+        std::remove(path.c_str());
+
+        auto pid = fork();
+        if (pid < 0) {
+            check(false, std::string(test.name) + ": fork");
+            return;
+        }
+        if (pid == 0) {
+            if (!crashcapture::install(path.c_str())) {
+                std::_Exit(2);
+            }
+            faultFrom(test.fault);
+            std::_Exit(3);
+        }
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        auto name = std::string(test.name) + ": ";
+        auto expected = [&](int signal) {
+            return std::find(test.signals.begin(), test.signals.end(), signal) != test.signals.end();
+        };
+        // the previous handler, the default one here, still gets the signal
+        check(
+            WIFSIGNALED(status) && expected(WTERMSIG(status)),
+            name + "child is killed by the signal after the capture"
+        );
+
+        auto capture = crashcapture::read(path.c_str());
+        check(capture.has_value(), name + "capture is written and readable");
+        if (!capture) return;
+
+        check(expected(capture->signal), name + "captured signal " + std::to_string(capture->signal));
+        if (test.checkAddress) {
+            check(capture->address == FAULT_ADDRESS, name + "captured fault address");
+        }
+        check(!capture->registers.empty(), name + "registers are captured");
+
+        auto mappings = capture->parseMappings();
+        check(!mappings.empty(), name + "mappings are captured and parse");
+
+        // a fork runs the same executable, so its code is at the same place
+        auto exe = getExecutablePath();
+        auto inExecutable = [&](uintptr_t address) {
+            return std::any_of(mappings.begin(), mappings.end(), [&](auto const& mapping) {
+                return mapping.path == exe && mapping.permissions.find('x') != std::string::npos &&
+                    mapping.start <= address && address < mapping.end;
+            });
+        };
+        check(
+            std::any_of(mappings.begin(), mappings.end(), [&](auto const& mapping) {
+                return mapping.path == exe;
+            }),
+            name + "mappings include the executable"
+        );
+
+        check(!capture->frames.empty(), name + "the faulting pc is captured");
+        if (test.checkFrames) {
+            // the pc and at least the frame of faultFrom
+            auto ownFrames = std::count_if(capture->frames.begin(), capture->frames.end(), inExecutable);
+            check(ownFrames >= 2, name + std::to_string(ownFrames) + " frames are in the executable");
+            check(inExecutable(capture->frames.front()), name + "the faulting pc is in the executable");
+        }
+
+        std::remove(path.c_str());
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string dir = argc > 1 ? argv[1] : "/tmp";
+
+    Case cases[] = {
+        { "segfault", &writeToNull, { SIGSEGV }, true, true },
+        { "abort", &callAbort, { SIGABRT }, false, false },
+        { "trap", &trap, { SIGILL, SIGTRAP }, false, true },
+        // only capturable because the handler runs on its own stack
+        { "stack-overflow", &overflow, { SIGSEGV }, false, true },
+    };
+    for (auto const& test : cases) {
+        runCase(test, dir);
+    }
+
+    return s_failed ? 1 : 0;
+}
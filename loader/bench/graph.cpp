@@ -0,0 +1,234 @@
+// Times the loader's mod graph refresh on generated mods without the game.
+// The real loader sources queue, list, link, unzip and check the mods; only
+// the platform code and cocos are stubbed (see graph_host.cpp).
+//
+// Usage: geode-loader-graph-bench [--runs <count>] [--output <file>] [--work-dir <dir>]
+//     [--mod-count <count>] [--mod-size <bytes>] [--fan-out <count>] [--broken-percent <percent>]
+//     [--log-count <count>]
+// The work dir stands in for the game directory and is cleared first. The
+// first run unzips every mod; later runs find them already unzipped, like
+// every launch after the first one does. The log/* cases time the real
+// logger writing to the log file in the work dir. Results are printed (or
+// written to the output file) as JSON
+
+#include "graph_host.hpp"
+#include "synthetic.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/Loader.hpp>
+#include <Geode/utils/file.hpp>
+#include <loader/LoaderImpl.hpp>
+#include <loader/LogImpl.hpp>
+#include <loader/ModImpl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace geode::prelude;
+
+namespace {
+    matjson::Value refresh() {
+        auto impl = LoaderImpl::get();
+
+        // every mod depends on the loader, so it collects the dependants of
+        // all the previous runs otherwise
+        ModImpl::getImpl(Mod::get())->m_dependants.clear();
+        log::Logger::get()->clear();
+
+        auto start = std::chrono::steady_clock::now();
+        impl->refreshModGraph();
+        // the unzipping happens on other threads, which post back to the
+        // main thread queue the same way they do in game
+        while (impl->m_loadingState != Loader::LoadingState::Done) {
+            impl->executeMainThreadQueue();
+            std::this_thread::yield();
+        }
+        auto time = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+        // events the mods queued while being set up
+        impl->executeMainThreadQueue();
+
+        auto phases = matjson::Array();
+        for (auto const& [name, phaseTime] : impl->m_phaseTimes) {
+            auto phase = matjson::Object();
+            phase["name"] = name;
+            phase["ms"] = static_cast<double>(phaseTime.count()) / 1000.0;
+            phases.push_back(phase);
+        }
+        auto enabled = std::count_if(impl->m_modList.begin(), impl->m_modList.end(), [](Mod* mod) {
+            return !mod->isInternal() && mod->isEnabled();
+        });
+
+        auto json = matjson::Object();
+        json["total-ms"] = time;
+        json["phases"] = phases;
+        // not counting the loader itself
+        json["mods"] = static_cast<double>(impl->m_modList.size() - 1);
+        json["enabled"] = static_cast<double>(enabled);
+        json["problems"] = static_cast<double>(impl->m_problems.size());
+        return json;
+    }
+
+    struct LogCase {
+        std::string name;
+        // lines `run` is asked to log
+        size_t logs;
+        std::function<void(size_t count)> run;
+    };
+
+    // the same lines from several threads at once, contending for the logger
+    void logFromThreads(size_t threads, size_t count) {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([count, threads]() {
+                for (size_t i = 0; i < count / threads; i++) {
+                    log::info("Line {} from a worker thread", i);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    matjson::Value timeLogs(size_t count) {
+        std::vector<LogCase> cases = {
+            { "log/info", count, [](size_t logs) {
+                for (size_t i = 0; i < logs; i++) {
+                    log::info("Refreshing the mod graph");
+                }
+            } },
+            { "log/info-format", count, [](size_t logs) {
+                for (size_t i = 0; i < logs; i++) {
+                    log::info("Mod {} has {} dependencies ({:.2f} ms)", "bench.mod-42", i, 3.14159);
+                }
+            } },
+            { "log/warn-nested", count, [](size_t logs) {
+                log::pushNest();
+                log::pushNest();
+                for (size_t i = 0; i < logs; i++) {
+                    log::warn("Unable to load a nested resource");
+                }
+                log::popNest();
+                log::popNest();
+            } },
+            { "log/info-4-threads", count / 4 * 4, [](size_t logs) {
+                logFromThreads(4, logs);
+            } },
+        };
+
+        auto results = matjson::Array();
+        for (auto const& logCase : cases) {
+            std::fprintf(stderr, "Timing %s\n", logCase.name.c_str());
+            log::Logger::get()->clear();
+
+            auto start = std::chrono::steady_clock::now();
+            logCase.run(logCase.logs);
+            auto time = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start
+            ).count();
+
+            auto json = matjson::Object();
+            json["name"] = logCase.name;
+            json["logs"] = static_cast<double>(logCase.logs);
+            json["ns-per-op"] = time / static_cast<double>(logCase.logs);
+            // the logger keeps every line in memory, which is part of the cost
+            json["kept"] = static_cast<double>(log::Logger::get()->list().size());
+            results.push_back(json);
+        }
+        log::Logger::get()->clear();
+        return results;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string output;
+    size_t runs = 5;
+    size_t logCount = 20'000;
+    ghc::filesystem::path workDir = ghc::filesystem::temp_directory_path() / "geode-loader-graph-bench";
+    bench::SyntheticModOptions modOptions;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        auto nextNumber = [&]() -> size_t {
+            return std::strtoul(argv[++i], nullptr, 10);
+        };
+        if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max<size_t>(nextNumber(), 1);
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        }
+        else if (arg == "--work-dir" && i + 1 < argc) {
+            workDir = argv[++i];
+        }
+        else if (arg == "--mod-count" && i + 1 < argc) {
+            modOptions.count = nextNumber();
+        }
+        else if (arg == "--mod-size" && i + 1 < argc) {
+            modOptions.size = nextNumber();
+        }
+        else if (arg == "--fan-out" && i + 1 < argc) {
+            modOptions.fanOut = nextNumber();
+        }
+        else if (arg == "--broken-percent" && i + 1 < argc) {
+            modOptions.brokenPercent = std::min<size_t>(nextNumber(), 100);
+        }
+        else if (arg == "--log-count" && i + 1 < argc) {
+            logCount = std::max<size_t>(nextNumber(), 4);
+        }
+        else {
+            std::fprintf(stderr,
+                "Usage: geode-loader-graph-bench [--runs <count>] [--output <file>] [--work-dir <dir>]\n"
+                "           [--mod-count <count>] [--mod-size <bytes>] [--fan-out <count>] [--broken-percent <percent>]\n"
+                "           [--log-count <count>]\n"
+            );
+            return 1;
+        }
+    }
+
+    std::error_code ec;
+    ghc::filesystem::remove_all(workDir, ec);
+    bench::graphWorkDir() = workDir;
+
+    auto impl = LoaderImpl::get();
+    // the generated mods only have placeholder binaries
+    impl->forceSafeMode();
+    impl->createDirectories();
+    log::Logger::get()->setup();
+
+    if (auto res = bench::generateSyntheticMods(dirs::getModsDir(), modOptions); !res) {
+        std::fprintf(stderr, "Unable to generate mods: %s\n", res.unwrapErr().c_str());
+        return 1;
+    }
+
+    auto results = matjson::Array();
+    for (size_t i = 0; i < runs; i++) {
+        std::fprintf(stderr, "Refreshing %zu mods (run %zu of %zu)\n", modOptions.count, i + 1, runs);
+        results.push_back(refresh());
+    }
+
+    auto json = matjson::Object();
+    json["platform"] = GEODE_PLATFORM_NAME;
+    json["mod-count"] = static_cast<double>(modOptions.count);
+    json["mod-size"] = static_cast<double>(modOptions.size);
+    json["fan-out"] = static_cast<double>(modOptions.fanOut);
+    json["broken-percent"] = static_cast<double>(modOptions.brokenPercent);
+    json["runs"] = results;
+    json["log-count"] = static_cast<double>(logCount);
+    json["logs"] = timeLogs(logCount);
+    auto str = matjson::Value(json).dump();
+
+    if (output.empty()) {
+        std::printf("%s\n", str.c_str());
+    }
+    else if (auto res = file::writeString(output, str); !res) {
+        std::fprintf(stderr, "Unable to write results: %s\n", res.unwrapErr().c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,190 @@
+// Stand-ins for the platform code, cocos and the index that the mod graph
+// sources reference, so the graph can be refreshed without the game.
+// Nothing here is on a timed path except the file utils search path, which
+// the real game keeps in memory as well
+
+#include "graph_host.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/Index.hpp>
+#include <Geode/loader/Loader.hpp>
+#include <Geode/loader/Setting.hpp>
+#include <Geode/utils/general.hpp>
+#include <cocos2d.h>
+#include <internal/FileWatcher.hpp>
+#include <internal/crashlog.hpp>
+#include <loader/LoaderImpl.hpp>
+#include <loader/ModImpl.hpp>
+#include <loader/console.hpp>
+#include <utils/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+using namespace geode::prelude;
+
+ghc::filesystem::path& bench::graphWorkDir() {
+    static ghc::filesystem::path dir;
+    return dir;
+}
+
+Mod* geode::getMod() {
+    return Mod::get();
+}
+
+// Dirs
+
+ghc::filesystem::path dirs::getGameDir() {
+    return bench::graphWorkDir();
+}
+
+ghc::filesystem::path dirs::getSaveDir() {
+    return bench::graphWorkDir() / "save";
+}
+
+ghc::filesystem::path dirs::getModRuntimeDir() {
+    return dirs::getGeodeDir() / "unzipped";
+}
+
+// Loader platform functions
+
+std::string Loader::Impl::getGameVersion() {
+    return GEODE_STR(GEODE_GD_VERSION);
+}
+
+bool Loader::Impl::userTriedToLoadDLLs() const {
+    return false;
+}
+
+void Loader::Impl::addNativeBinariesPath(ghc::filesystem::path const& path) {}
+
+bool Loader::Impl::supportsLaunchArguments() const {
+    return false;
+}
+
+std::string Loader::Impl::getLaunchCommand() const {
+    return std::string();
+}
+
+// the bench only loads in safe mode, which never gets this far
+Result<> Mod::Impl::loadPlatformBinary() {
+    return Err("Binaries can't be loaded by the bench");
+}
+
+void geode::utils::game::exit() {
+    std::exit(0);
+}
+
+void geode::utils::game::launchLoaderUninstaller(bool deleteSaveData) {}
+
+std::string geode::utils::thread::getDefaultName() {
+    std::stringstream str;
+    str << "Thread #" << std::this_thread::get_id();
+    return str.str();
+}
+
+void geode::utils::thread::platformSetName(std::string const& name) {}
+
+// The console would print every log line, which is not what's being timed;
+// the logs still go to the log file in the work dir
+
+void console::setup() {}
+
+void console::openIfClosed() {}
+
+void console::log(std::string const& msg, Severity severity) {}
+
+void console::messageBox(char const* title, std::string const& info, Severity severity) {
+    std::fprintf(stderr, "%s: %s\n", title, info.c_str());
+}
+
+bool crashlog::setupPlatformHandler() {
+    return false;
+}
+
+ghc::filesystem::path crashlog::getCrashLogDirectory() {
+    return dirs::getGeodeDir() / "crashlogs";
+}
+
+FileWatcher::FileWatcher(
+    ghc::filesystem::path const& file, FileWatchCallback callback, ErrorCallback error
+) :
+    m_file(file),
+    m_callback(std::move(callback)),
+    m_error(std::move(error)),
+    m_platformHandle(nullptr) {}
+
+FileWatcher::~FileWatcher() {}
+
+bool FileWatcher::watching() const {
+    return false;
+}
+
+// The generated mods have no settings, and Setting.cpp brings in the UI
+
+Result<Setting> Setting::parse(std::string const& key, std::string const& mod, JsonMaybeValue& obj) {
+    return Err("Settings aren't supported by the bench");
+}
+
+std::unique_ptr<SettingValue> Setting::createDefaultValue() const {
+    return nullptr;
+}
+
+// Mod::hasAvailableUpdate is the only user and it's never called
+
+Index* Index::get() {
+    return nullptr;
+}
+
+IndexItemHandle Index::getItem(std::string const& id, std::optional<VersionInfo> version) const {
+    return nullptr;
+}
+
+ModMetadata IndexItem::getMetadata() const {
+    return ModMetadata();
+}
+
+std::unordered_set<PlatformID> IndexItem::getAvailablePlatforms() const {
+    return {};
+}
+
+// Cocos
+
+#pragma warning(push)
+#pragma warning(disable : 4273)
+
+namespace {
+    // Mods add their resource dirs as search paths while they're set up.
+    // Built with the zero constructor so the real one, which needs the
+    // game, is never called
+    class BenchFileUtils : public CCFileUtils {
+    public:
+        BenchFileUtils() : CCFileUtils(geode::ZeroConstructor, sizeof(BenchFileUtils)) {}
+
+        void addSearchPath(char const* path) override {
+            m_paths.emplace_back(path);
+        }
+
+        std::vector<std::string> m_paths;
+    };
+}
+
+CCFileUtils* CCFileUtils::get() {
+    static auto fileUtils = new BenchFileUtils();
+    return fileUtils;
+}
+
+void CCFileUtils::addPriorityPath(char const* path) {}
+
+// resources are never loaded by the bench
+
+CCTextureCache* CCTextureCache::get() {
+    return nullptr;
+}
+
+CCSpriteFrameCache* CCSpriteFrameCache::get() {
+    return nullptr;
+}
+
+#pragma warning(pop)
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <ghc/fs_fwd.hpp>
+
+namespace bench {
+    /**
+     * The directory geode-loader-graph-bench uses in place of the game's
+     * directory; the stubbed dirs:: functions all point inside it
+     */
+    ghc::filesystem::path& graphWorkDir();
+}
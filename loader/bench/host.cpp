@@ -0,0 +1,44 @@
+// Stand-ins for the few loader entry points that the benchmarked sources
+// reference but that need the game to be running. None of these are on a
+// benchmarked path
+
+#include <Geode/loader/Loader.hpp>
+#include <Geode/loader/Log.hpp>
+#include <internal/FileWatcher.hpp>
+#include <cstdio>
+
+using namespace geode::prelude;
+
+Mod* geode::getMod() {
+    return nullptr;
+}
+
+// The logger needs the loader and a console, so logs from the benchmarked
+// code go straight to stderr instead. The real logger is timed by the log/*
+// cases of geode-loader-graph-bench
+void log::vlogImpl(Severity, Mod*, fmt::string_view format, fmt::format_args args) {
+    std::fprintf(stderr, "%s\n", fmt::vformat(format, args).c_str());
+}
+
+// file::watchFile is never called by the bench
+Loader* Loader::get() {
+    return nullptr;
+}
+
+void Loader::queueInMainThread(ScheduledFunction func) {
+    func();
+}
+
+FileWatcher::FileWatcher(
+    ghc::filesystem::path const& file, FileWatchCallback callback, ErrorCallback error
+) :
+    m_file(file),
+    m_callback(std::move(callback)),
+    m_error(std::move(error)),
+    m_platformHandle(nullptr) {}
+
+FileWatcher::~FileWatcher() {}
+
+bool FileWatcher::watching() const {
+    return false;
+}
@@ -0,0 +1,467 @@
+// Micro-benchmarks for the loader's pure C++ utilities. Every benchmark
+// runs on a fixed dataset so results can be compared between releases.
+//
+// Usage: geode-loader-bench [--filter <text>] [--samples <count>] [--output <file>]
+// Results are printed (or written to the output file) as JSON
+//
+// geode-loader-bench --generate-mods <dir> [--mod-count <count>] [--mod-size <bytes>]
+//     [--fan-out <count>] [--broken-percent <percent>]
+// generates synthetic .geode packages for timing the loader's startup
+
+#include "synthetic.hpp"
+
+#include <Geode/loader/Dispatch.hpp>
+#include <Geode/loader/Event.hpp>
+#include <Geode/utils/JsonValidation.hpp>
+#include <Geode/utils/MiniFunction.hpp>
+#include <Geode/utils/VersionInfo.hpp>
+#include <Geode/utils/casts.hpp>
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/string.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+
+using namespace geode::prelude;
+
+namespace {
+    // results are added here so the compiler can't drop the benchmarked code
+    volatile size_t s_sink = 0;
+
+    void keep(size_t value) {
+        s_sink = s_sink + value;
+    }
+
+    struct Benchmark {
+        std::string name;
+        // calls of `run` per sample
+        size_t iterations;
+        std::function<void()> run;
+    };
+
+    struct BenchmarkResult {
+        std::string name;
+        size_t iterations;
+        std::vector<double> samples;
+
+        matjson::Value toJSON() const {
+            auto sorted = samples;
+            std::sort(sorted.begin(), sorted.end());
+            auto json = matjson::Object();
+            json["name"] = name;
+            json["iterations"] = static_cast<double>(iterations);
+            json["samples"] = static_cast<double>(sorted.size());
+            json["min-ns-per-op"] = sorted.front();
+            json["median-ns-per-op"] = sorted[sorted.size() / 2];
+            json["max-ns-per-op"] = sorted.back();
+            return json;
+        }
+    };
+
+    BenchmarkResult runBenchmark(Benchmark const& bench, size_t samples) {
+        BenchmarkResult result { bench.name, bench.iterations };
+        // warm up caches and any lazily created state
+        for (size_t i = 0; i < std::max<size_t>(bench.iterations / 10, 1); i++) {
+            bench.run();
+        }
+        for (size_t s = 0; s < samples; s++) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < bench.iterations; i++) {
+                bench.run();
+            }
+            auto time = std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start
+            ).count();
+            result.samples.push_back(time / static_cast<double>(bench.iterations));
+        }
+        return result;
+    }
+
+    // Datasets
+
+    constexpr char const* MOD_JSON = R"JSON({
+        "geode": "2.0.0",
+        "gd": { "win": "2.204", "android": "2.205", "mac": "2.200" },
+        "id": "bench.example-mod",
+        "name": "Example Mod",
+        "version": "v1.4.2-beta.3",
+        "developer": "Bench",
+        "description": "A mod.json that uses most of the fields the loader reads",
+        "repository": "https://github.com/geode-sdk/example",
+        "early-load": false,
+        "tags": ["gameplay", "utility", "interface"],
+        "dependencies": [
+            { "id": "geode.node-ids", "version": ">=v1.0.0", "importance": "required" },
+            { "id": "bench.dependency", "version": "v2.1.0", "importance": "recommended" },
+            { "id": "bench.mac-only", "version": "v1.0.0", "platforms": ["mac"] }
+        ],
+        "incompatibilities": [
+            { "id": "bench.conflict", "version": "<=v0.9.0", "importance": "breaking" }
+        ],
+        "settings": {
+            "enabled": { "type": "bool", "default": true, "name": "Enabled" },
+            "speed": { "type": "float", "default": 1.5, "min": 0.1, "max": 10 },
+            "title": { "type": "string", "default": "Hello", "platforms": ["win", "mac"] }
+        },
+        "resources": {
+            "spritesheets": { "Sheet": ["resources/*.png"] },
+            "sprites": ["logo.png"]
+        },
+        "issues": { "info": "Report issues on GitHub", "url": "https://github.com/geode-sdk/example/issues" }
+    })JSON";
+
+    std::vector<std::string> const VERSIONS = {
+        "v1.0.0", "1.2.3", "v2.0.0-alpha", "v2.0.0-beta.4", "v10.21.3-prerelease.12",
+        "v0.0.1", "3.14.159", "v1.4.2-beta.3", "v4.0.0-alpha.1", "v99.99.99",
+    };
+
+    constexpr char const* TEXT =
+        "  The Quick Brown Fox Jumps Over The Lazy Dog, while Geode loads mods "
+        "one by one and checks every dependency, setting and resource on the way.  ";
+
+    struct BenchEvent : public Event {
+        size_t value;
+        BenchEvent(size_t value) : value(value) {}
+    };
+
+    struct BenchBase {
+        virtual ~BenchBase() = default;
+    };
+    struct BenchMiddle : public BenchBase {};
+    struct BenchDerived : public BenchMiddle {
+        size_t value = 1;
+    };
+    struct BenchOther : public BenchBase {};
+
+    ByteVector createArchive() {
+        auto zip = file::Zip::create().unwrap();
+        for (size_t i = 0; i < 64; i++) {
+            std::string data;
+            for (size_t j = 0; j < 256; j++) {
+                data += fmt::format("entry {} line {}\n", i, j);
+            }
+            (void)zip.add(fmt::format("data/file-{}.txt", i), data);
+        }
+        return zip.getData();
+    }
+
+    void checkModJson(matjson::Value& json) {
+        JsonChecker checker(json);
+        auto root = checker.root("[mod.json]").obj();
+
+        std::string id;
+        std::string name;
+        std::string developer;
+        std::optional<std::string> description;
+        VersionInfo version;
+        root.needs("geode").into(id);
+        root.addKnownKey("gd");
+        root.addKnownKey("tags");
+        root.needs("id").into(id);
+        root.needs("version").into(version);
+        root.needs("name").into(name);
+        root.needs("developer").into(developer);
+        root.has("description").into(description);
+        root.has("repository").into(description);
+        root.has("early-load");
+        for (auto& dep : root.has("dependencies").iterate()) {
+            auto obj = dep.obj();
+            ComparableVersionInfo depVersion;
+            obj.needs("id").into(id);
+            obj.needs("version").into(depVersion);
+            obj.has("importance");
+            obj.has("platforms");
+            obj.checkUnknownKeys();
+        }
+        for (auto& incompat : root.has("incompatibilities").iterate()) {
+            auto obj = incompat.obj();
+            ComparableVersionInfo incompatVersion;
+            obj.needs("id").into(id);
+            obj.needs("version").into(incompatVersion);
+            obj.has("importance");
+            obj.checkUnknownKeys();
+        }
+        for (auto& [key, value] : root.has("settings").items()) {
+            auto obj = value.obj();
+            obj.needs("type").into(name);
+            keep(key.size());
+        }
+        if (auto resources = root.has("resources").obj()) {
+            for (auto& [key, _] : resources.has("spritesheets").items()) {
+                keep(key.size());
+            }
+        }
+        if (auto issues = root.has("issues").obj()) {
+            issues.needs("info").into(name);
+            issues.has("url").into(description);
+        }
+        root.checkUnknownKeys();
+        keep(checker.isError() ? 0 : id.size() + name.size());
+    }
+
+    std::vector<Benchmark> createBenchmarks() {
+        std::vector<Benchmark> benchmarks;
+
+        // DefaultEventListenerPool
+
+        auto listeners = std::make_shared<std::vector<std::unique_ptr<EventListener<EventFilter<BenchEvent>>>>>();
+        for (size_t i = 0; i < 64; i++) {
+            listeners->push_back(std::make_unique<EventListener<EventFilter<BenchEvent>>>(
+                [](BenchEvent* ev) {
+                    keep(ev->value);
+                    return ListenerResult::Propagate;
+                }
+            ));
+        }
+        benchmarks.push_back({ "event/post-64-listeners", 20'000, [listeners]() {
+            BenchEvent(1).post();
+        } });
+        benchmarks.push_back({ "event/add-remove-listener", 200'000, []() {
+            EventListener<EventFilter<BenchEvent>> listener(
+                [](BenchEvent*) { return ListenerResult::Propagate; }
+            );
+            keep(1);
+        } });
+
+        // Dispatch
+
+        using BenchDispatchFilter = DispatchFilter<size_t, std::string>;
+        auto dispatchListener = std::make_shared<EventListener<BenchDispatchFilter>>(
+            [](size_t value, std::string text) {
+                keep(value + text.size());
+                return ListenerResult::Propagate;
+            },
+            BenchDispatchFilter("bench/dispatch")
+        );
+        benchmarks.push_back({ "dispatch/post-by-id", 200'000, [dispatchListener]() {
+            DispatchEvent<size_t, std::string>("bench/dispatch", 1, "argument").post();
+        } });
+
+        static DispatchChannel const dispatchChannel("bench/dispatch-channel");
+        using BenchChannelFilter = DispatchChannelFilter<size_t, std::string>;
+        auto channelListener = std::make_shared<EventListener<BenchChannelFilter>>(
+            [](size_t value, std::string text) {
+                keep(value + text.size());
+                return ListenerResult::Propagate;
+            },
+            BenchChannelFilter(dispatchChannel)
+        );
+        benchmarks.push_back({ "dispatch/post-on-channel", 200'000, [channelListener]() {
+            DispatchChannelEvent<size_t, std::string>(dispatchChannel, 1, "argument").post();
+        } });
+
+        // MiniFunction
+
+        benchmarks.push_back({ "minifunction/construct-call", 1'000'000, []() {
+            size_t captured = s_sink;
+            MiniFunction<size_t(size_t)> fn = [captured](size_t v) { return v + captured; };
+            keep(fn(1));
+        } });
+        auto storedFn = std::make_shared<MiniFunction<size_t(size_t)>>([](size_t v) { return v * 3; });
+        benchmarks.push_back({ "minifunction/call", 5'000'000, [storedFn]() {
+            keep((*storedFn)(s_sink & 0xff));
+        } });
+        benchmarks.push_back({ "minifunction/copy", 1'000'000, [storedFn]() {
+            auto copy = *storedFn;
+            keep(copy(1));
+        } });
+
+        // typeinfo_cast
+
+        auto derived = std::make_shared<BenchDerived>();
+        auto other = std::make_shared<BenchOther>();
+        benchmarks.push_back({ "typeinfo-cast/hit", 5'000'000, [derived]() {
+            BenchBase* base = derived.get();
+            auto res = typeinfo_cast<BenchDerived*>(base);
+            keep(res ? res->value : 0);
+        } });
+        benchmarks.push_back({ "typeinfo-cast/miss", 5'000'000, [other]() {
+            BenchBase* base = other.get();
+            keep(typeinfo_cast<BenchDerived*>(base) ? 1 : 0);
+        } });
+
+        // file::Unzip
+
+        auto archive = std::make_shared<ByteVector>(createArchive());
+        benchmarks.push_back({ "unzip/open-64-entries", 2'000, [archive]() {
+            auto unzip = file::Unzip::create(*archive).unwrap();
+            keep(unzip.getEntries().size());
+        } });
+        auto unzip = std::make_shared<file::Unzip>(file::Unzip::create(*archive).unwrap());
+        benchmarks.push_back({ "unzip/extract", 5'000, [unzip]() {
+            auto data = unzip->extract("data/file-31.txt").unwrap();
+            keep(data.size());
+        } });
+
+        // JsonChecker
+
+        auto modJson = std::make_shared<matjson::Value>(matjson::parse(MOD_JSON));
+        benchmarks.push_back({ "json/parse-mod-json", 20'000, []() {
+            auto json = matjson::parse(MOD_JSON);
+            keep(json.is_object() ? 1 : 0);
+        } });
+        benchmarks.push_back({ "json/check-mod-json", 20'000, [modJson]() {
+            checkModJson(*modJson);
+        } });
+
+        // VersionInfo
+
+        benchmarks.push_back({ "version/parse", 100'000, []() {
+            for (auto& str : VERSIONS) {
+                auto res = VersionInfo::parse(str);
+                keep(res ? res.unwrap().getMajor() : 0);
+            }
+        } });
+        benchmarks.push_back({ "version/parse-comparable", 100'000, []() {
+            auto res = ComparableVersionInfo::parse(">=v1.2.3-beta.4");
+            keep(res ? 1 : 0);
+        } });
+        benchmarks.push_back({ "version/compare", 1'000'000, []() {
+            static auto a = VersionInfo::parse("v1.4.2-beta.3").unwrap();
+            static auto b = VersionInfo::parse("v1.4.2").unwrap();
+            keep(a < b ? 1 : 0);
+        } });
+        benchmarks.push_back({ "version/sort", 100'000, []() {
+            static auto const parsed = [] {
+                std::vector<VersionInfo> parsed;
+                for (auto& str : VERSIONS) {
+                    parsed.push_back(VersionInfo::parse(str).unwrap());
+                }
+                return parsed;
+            }();
+            auto versions = parsed;
+            std::sort(versions.begin(), versions.end());
+            keep(versions.front().getMajor());
+        } });
+
+        // utils::string
+
+        benchmarks.push_back({ "string/to-lower", 500'000, []() {
+            keep(utils::string::toLower(TEXT).size());
+        } });
+        benchmarks.push_back({ "string/split", 200'000, []() {
+            keep(utils::string::split(TEXT, " ").size());
+        } });
+        benchmarks.push_back({ "string/replace", 200'000, []() {
+            keep(utils::string::replace(TEXT, "o", "0").size());
+        } });
+        benchmarks.push_back({ "string/trim", 500'000, []() {
+            keep(utils::string::trim(TEXT).size());
+        } });
+        benchmarks.push_back({ "string/contains", 1'000'000, []() {
+            keep(utils::string::contains(TEXT, "resource") ? 1 : 0);
+        } });
+        // the allocation-free versions, next to the ones above
+        benchmarks.push_back({ "string/split-view", 200'000, []() {
+            size_t parts = 0;
+            for (auto part : utils::string::splitView(TEXT, " ")) {
+                parts += part.size();
+            }
+            keep(parts);
+        } });
+        benchmarks.push_back({ "string/trim-view", 500'000, []() {
+            keep(utils::string::trimView(TEXT).size());
+        } });
+        benchmarks.push_back({ "string/to-lower-ip", 500'000, []() {
+            static std::string str = TEXT;
+            keep(utils::string::toLowerIP(str).size());
+        } });
+        benchmarks.push_back({ "string/find", 1'000'000, []() {
+            keep(utils::string::find(TEXT, "resource"));
+        } });
+        benchmarks.push_back({ "string/std-find", 1'000'000, []() {
+            keep(std::string_view(TEXT).find("resource"));
+        } });
+        benchmarks.push_back({ "string/count", 1'000'000, []() {
+            static std::string str = TEXT;
+            keep(utils::string::count(str, 'e'));
+        } });
+        benchmarks.push_back({ "string/std-count", 1'000'000, []() {
+            std::string_view str = TEXT;
+            keep(std::count(str.begin(), str.end(), 'e'));
+        } });
+
+        return benchmarks;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string output;
+    size_t samples = 5;
+    std::string generateDir;
+    bench::SyntheticModOptions modOptions;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        auto nextNumber = [&]() -> size_t {
+            return std::strtoul(argv[++i], nullptr, 10);
+        };
+        if (arg == "--generate-mods" && i + 1 < argc) {
+            generateDir = argv[++i];
+        }
+        else if (arg == "--mod-count" && i + 1 < argc) {
+            modOptions.count = nextNumber();
+        }
+        else if (arg == "--mod-size" && i + 1 < argc) {
+            modOptions.size = nextNumber();
+        }
+        else if (arg == "--fan-out" && i + 1 < argc) {
+            modOptions.fanOut = nextNumber();
+        }
+        else if (arg == "--broken-percent" && i + 1 < argc) {
+            modOptions.brokenPercent = std::min<size_t>(nextNumber(), 100);
+        }
+        else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        }
+        else if (arg == "--samples" && i + 1 < argc) {
+            samples = std::max<size_t>(nextNumber(), 1);
+        }
+        else {
+            std::fprintf(stderr,
+                "Usage: geode-loader-bench [--filter <text>] [--samples <count>] [--output <file>]\n"
+                "       geode-loader-bench --generate-mods <dir> [--mod-count <count>] [--mod-size <bytes>]\n"
+                "           [--fan-out <count>] [--broken-percent <percent>]\n"
+            );
+            return 1;
+        }
+    }
+
+    if (!generateDir.empty()) {
+        if (auto res = bench::generateSyntheticMods(generateDir, modOptions); !res) {
+            std::fprintf(stderr, "Unable to generate mods: %s\n", res.unwrapErr().c_str());
+            return 1;
+        }
+        std::fprintf(stderr, "Generated %zu mods in %s\n", modOptions.count, generateDir.c_str());
+        return 0;
+    }
+
+    auto results = matjson::Array();
+    for (auto& bench : createBenchmarks()) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        std::fprintf(stderr, "Running %s\n", bench.name.c_str());
+        results.push_back(runBenchmark(bench, samples).toJSON());
+    }
+
+    auto json = matjson::Object();
+    json["platform"] = GEODE_PLATFORM_NAME;
+    json["benchmarks"] = results;
+    auto str = matjson::Value(json).dump();
+
+    if (output.empty()) {
+        std::printf("%s\n", str.c_str());
+    }
+    else if (auto res = file::writeString(output, str); !res) {
+        std::fprintf(stderr, "Unable to write results: %s\n", res.unwrapErr().c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "synthetic.hpp"
+
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/general.hpp>
+#include <matjson.hpp>
+#include <fmt/format.h>
+
+using namespace geode::prelude;
+
+namespace {
+    enum class BrokenKind {
+        InvalidJSON,
+        MissingDependency,
+        DuplicateID,
+        UnsupportedGDVersion,
+        OutdatedDependency,
+        Incompatible,
+    };
+    constexpr size_t BROKEN_KIND_COUNT = 6;
+
+    std::string modID(size_t index) {
+        return fmt::format("bench.synthetic-{}", index);
+    }
+
+    matjson::Value createModJson(
+        size_t index, bench::SyntheticModOptions const& options, std::optional<BrokenKind> broken
+    ) {
+        auto json = matjson::Object();
+        json["geode"] = GEODE_BENCH_VERSION;
+        json["gd"] = broken == BrokenKind::UnsupportedGDVersion ? "1.000" : GEODE_BENCH_GD_VERSION;
+        json["id"] = broken == BrokenKind::DuplicateID ? modID(0) : modID(index);
+        json["name"] = fmt::format("Synthetic Mod {}", index);
+        json["version"] = "v1.0.0";
+        json["developer"] = "Bench";
+        json["description"] = "Generated by geode-loader-bench";
+
+        auto dependencies = matjson::Array();
+        for (size_t i = 0; i < options.fanOut && i < index; i++) {
+            auto dep = matjson::Object();
+            dep["id"] = modID(index - 1 - i);
+            dep["version"] = (broken == BrokenKind::OutdatedDependency && i == 0) ? ">=v2.0.0" : ">=v1.0.0";
+            dep["importance"] = "required";
+            dependencies.push_back(dep);
+        }
+        if (broken == BrokenKind::MissingDependency) {
+            auto dep = matjson::Object();
+            dep["id"] = "bench.synthetic-missing";
+            dep["version"] = ">=v1.0.0";
+            dep["importance"] = "required";
+            dependencies.push_back(dep);
+        }
+        json["dependencies"] = dependencies;
+
+        if (broken == BrokenKind::Incompatible && index > 0) {
+            auto incompat = matjson::Object();
+            incompat["id"] = modID(index - 1);
+            incompat["version"] = ">=v1.0.0";
+            incompat["importance"] = "breaking";
+            auto incompatibilities = matjson::Array();
+            incompatibilities.push_back(incompat);
+            json["incompatibilities"] = incompatibilities;
+        }
+        return json;
+    }
+}
+
+Result<> bench::generateSyntheticMods(
+    ghc::filesystem::path const& dir, SyntheticModOptions const& options
+) {
+    GEODE_UNWRAP(file::createDirectoryAll(dir));
+
+    // the same padding for every package; it's only there for the size
+    ByteVector padding(options.size);
+    for (size_t i = 0; i < padding.size(); i++) {
+        padding[i] = static_cast<uint8_t>((i * 2654435761u) >> 24);
+    }
+
+    size_t brokenCount = 0;
+    for (size_t i = 0; i < options.count; i++) {
+        // spread the broken mods evenly over the list
+        std::optional<BrokenKind> broken;
+        if ((i + 1) * options.brokenPercent / 100 != i * options.brokenPercent / 100) {
+            broken = static_cast<BrokenKind>(brokenCount++ % BROKEN_KIND_COUNT);
+        }
+
+        auto modJson = createModJson(i, options, broken);
+        auto json = modJson.dump();
+        if (broken == BrokenKind::InvalidJSON) {
+            json.resize(json.size() / 2);
+        }
+
+        auto path = dir / (modID(i) + ".geode");
+        GEODE_UNWRAP_INTO(auto zip, file::Zip::create(path));
+        GEODE_UNWRAP(zip.add("mod.json", json));
+        GEODE_UNWRAP(zip.add("resources/padding.bin", padding));
+        // the loader won't unzip a package without a binary for the current
+        // platform. It's never loaded, so it can be empty
+        GEODE_UNWRAP(zip.add(modJson["id"].as_string() + GEODE_PLATFORM_EXTENSION, ""));
+    }
+    return Ok();
+}
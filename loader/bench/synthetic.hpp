@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Geode/utils/Result.hpp>
+#include <ghc/fs_fwd.hpp>
+#include <cstddef>
+
+namespace bench {
+    struct SyntheticModOptions {
+        size_t count = 500;
+        // size of the resource padding in each package, in bytes
+        size_t size = 64 * 1024;
+        // how many earlier mods each mod depends on
+        size_t fanOut = 3;
+        // percentage of mods that are broken in some way
+        size_t brokenPercent = 5;
+    };
+
+    /**
+     * Generate a directory of .geode packages for timing the loader's mod
+     * graph refresh. The packages only have empty placeholder binaries, so
+     * load them in safe mode: either in the game with
+     * `--geode:safe-mode --geode:extra-mods-dir=<dir>`, or headless with
+     * geode-loader-graph-bench. The refresh logs how long each phase took
+     */
+    geode::Result<> generateSyntheticMods(
+        ghc::filesystem::path const& dir, SyntheticModOptions const& options
+    );
+}
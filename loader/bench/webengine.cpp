@@ -0,0 +1,307 @@
+// Checks the web engine's scheduling against a local HTTP stub server: the
+// limit of concurrent transfers, priority order, blocking transfers skipping
+// the limit, and connections being reused between transfers.
+//
+// Usage: geode-loader-web-test
+// Exits with 1 if any check fails
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+#include <utils/WebEngine.hpp>
+#include <Geode/utils/general.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace geode::prelude;
+using namespace geode::utils::web;
+
+// the engine names its thread, which is all it needs from utils::thread
+void geode::utils::thread::setName(std::string const& name) {}
+
+namespace {
+#ifdef _WIN32
+    using Socket = SOCKET;
+
+    void closeSocket(Socket socket) {
+        closesocket(socket);
+    }
+#else
+    using Socket = int;
+    constexpr Socket INVALID_SOCKET = -1;
+
+    void closeSocket(Socket socket) {
+        close(socket);
+    }
+#endif
+
+    /**
+     * Serves `GET /<name>/<delay in ms>` with a short body after the delay,
+     * keeping connections alive. Records the order requests arrived in, how
+     * many were being served at once and how many connections were opened
+     */
+    class StubServer final {
+    public:
+        struct Stats {
+            std::vector<std::string> order;
+            size_t maxInFlight = 0;
+            size_t connections = 0;
+        };
+
+    private:
+        Socket m_listener = INVALID_SOCKET;
+        uint16_t m_port = 0;
+        std::mutex m_mutex;
+        Stats m_stats;
+        size_t m_inFlight = 0;
+
+        void serve(Socket client) {
+            std::string buffer;
+            char data[1024];
+            while (true) {
+                auto end = buffer.find("\r\n\r\n");
+                if (end == std::string::npos) {
+                    auto read = recv(client, data, sizeof(data), 0);
+                    if (read <= 0) break;
+                    buffer.append(data, read);
+                    continue;
+                }
+                // "GET /<name>/<delay> HTTP/1.1"
+                auto requestLine = buffer.substr(0, buffer.find("\r\n"));
+                buffer.erase(0, end + 4);
+                auto pathStart = requestLine.find(' ') + 2;
+                auto path = requestLine.substr(pathStart, requestLine.find(' ', pathStart) - pathStart);
+                auto split = path.find('/');
+                auto name = path.substr(0, split);
+                auto delay = split == std::string::npos ? 0 : std::stoi(path.substr(split + 1));
+
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_stats.order.push_back(name);
+                    m_inFlight += 1;
+                    m_stats.maxInFlight = std::max(m_stats.maxInFlight, m_inFlight);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_inFlight -= 1;
+                }
+
+                std::string response =
+                    "HTTP/1.1 200 OK\r\n"
+                    "Content-Type: text/plain\r\n"
+                    "Content-Length: 2\r\n"
+                    "Connection: keep-alive\r\n"
+                    "\r\n"
+                    "ok";
+                if (send(client, response.data(), static_cast<int>(response.size()), 0) <= 0) break;
+            }
+            closeSocket(client);
+        }
+
+    public:
+        bool start() {
+            m_listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (m_listener == INVALID_SOCKET) return false;
+
+            sockaddr_in addr {};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+            if (bind(m_listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) return false;
+            if (listen(m_listener, 16) != 0) return false;
+
+            socklen_t size = sizeof(addr);
+            getsockname(m_listener, reinterpret_cast<sockaddr*>(&addr), &size);
+            m_port = ntohs(addr.sin_port);
+
+            std::thread([this]() {
+                while (true) {
+                    auto client = accept(m_listener, nullptr, nullptr);
+                    if (client == INVALID_SOCKET) return;
+                    {
+                        std::lock_guard lock(m_mutex);
+                        m_stats.connections += 1;
+                    }
+                    std::thread(&StubServer::serve, this, client).detach();
+                }
+            }).detach();
+            return true;
+        }
+
+        std::string url(std::string const& name, int delay) const {
+            return fmt::format("http://127.0.0.1:{}/{}/{}", m_port, name, delay);
+        }
+
+        // the stats since the last call
+        Stats takeStats() {
+            std::lock_guard lock(m_mutex);
+            return std::exchange(m_stats, Stats());
+        }
+    };
+
+    StubServer s_server;
+    bool s_failed = false;
+
+    void check(bool condition, std::string const& what) {
+        std::fprintf(stderr, "%s: %s\n", condition ? "ok" : "FAILED", what.c_str());
+        if (!condition) s_failed = true;
+    }
+
+    CURL* createTransfer(std::string const& url) {
+        auto handle = WebEngine::get()->createHandle();
+        curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, +[](char*, size_t size, size_t count, void*) {
+            return size * count;
+        });
+        return handle;
+    }
+
+    // Queues transfers and waits for all of them to finish
+    class Transfers final {
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        size_t m_running = 0;
+        bool m_allOk = true;
+
+    public:
+        void enqueue(std::string const& url, int priority) {
+            {
+                std::lock_guard lock(m_mutex);
+                m_running += 1;
+            }
+            auto handle = createTransfer(url);
+            WebEngine::get()->enqueue(handle, priority, [this, handle](CURLcode res) {
+                WebEngine::get()->releaseHandle(handle);
+                std::lock_guard lock(m_mutex);
+                m_allOk = m_allOk && res == CURLE_OK;
+                m_running -= 1;
+                m_cv.notify_all();
+            });
+        }
+
+        bool wait() {
+            std::unique_lock lock(m_mutex);
+            auto done = m_cv.wait_for(lock, std::chrono::seconds(20), [this]() {
+                return m_running == 0;
+            });
+            return done && m_allOk;
+        }
+    };
+
+    void checkConcurrencyLimit() {
+        WebEngine::get()->setMaxConcurrentTransfers(2);
+        s_server.takeStats();
+
+        Transfers transfers;
+        for (int i = 0; i < 6; i++) {
+            transfers.enqueue(s_server.url(fmt::format("limit-{}", i), 100), 0);
+        }
+        check(transfers.wait(), "limited transfers finish");
+        auto stats = s_server.takeStats();
+        check(stats.order.size() == 6, "every limited transfer reaches the server");
+        check(stats.maxInFlight <= 2, fmt::format("at most 2 transfers at once (saw {})", stats.maxInFlight));
+    }
+
+    void checkPriorityOrder() {
+        WebEngine::get()->setMaxConcurrentTransfers(1);
+        s_server.takeStats();
+
+        // the rest are queued while the first one holds the only slot
+        Transfers transfers;
+        transfers.enqueue(s_server.url("first", 300), 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        transfers.enqueue(s_server.url("low-a", 0), 0);
+        transfers.enqueue(s_server.url("low-b", 0), 0);
+        transfers.enqueue(s_server.url("high", 0), 10);
+        transfers.enqueue(s_server.url("low-c", 0), -5);
+        check(transfers.wait(), "prioritized transfers finish");
+
+        auto stats = s_server.takeStats();
+        std::vector<std::string> expected = { "first", "high", "low-a", "low-b", "low-c" };
+        check(stats.order == expected, fmt::format(
+            "transfers start by priority, then in queue order (saw {})", fmt::join(stats.order, ", ")
+        ));
+    }
+
+    void checkBlockingSkipsLimit() {
+        WebEngine::get()->setMaxConcurrentTransfers(1);
+        s_server.takeStats();
+
+        Transfers transfers;
+        transfers.enqueue(s_server.url("slow", 500), 0);
+        // make sure the slow one has the slot first
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        auto handle = createTransfer(s_server.url("blocking", 0));
+        size_t polls = 0;
+        auto res = WebEngine::get()->perform(handle, 0, [&]() {
+            polls += 1;
+        });
+        WebEngine::get()->releaseHandle(handle);
+        auto stats = s_server.takeStats();
+        check(res == CURLE_OK, "blocking transfer succeeds");
+        check(polls >= 1, "blocking transfer polls on the calling thread");
+        check(
+            stats.order.size() == 2 && stats.order.back() == "blocking",
+            "blocking transfer runs while the limit is reached"
+        );
+        check(transfers.wait(), "slow transfer finishes");
+    }
+
+    void checkConnectionReuse() {
+        WebEngine::get()->setMaxConcurrentTransfers(1);
+        // start from an idle engine so no earlier connection is still busy
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        s_server.takeStats();
+
+        bool allOk = true;
+        for (int i = 0; i < 5; i++) {
+            auto handle = createTransfer(s_server.url(fmt::format("reuse-{}", i), 0));
+            allOk = allOk && WebEngine::get()->perform(handle) == CURLE_OK;
+            WebEngine::get()->releaseHandle(handle);
+        }
+        check(allOk, "sequential transfers succeed");
+        // the earlier checks may have left connections open for this one to
+        // pick up, so it may not need a new one at all
+        auto stats = s_server.takeStats();
+        check(stats.connections <= 1, fmt::format(
+            "sequential transfers share a connection (opened {})", stats.connections
+        ));
+    }
+}
+
+int main() {
+#ifdef _WIN32
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    if (!s_server.start()) {
+        std::fprintf(stderr, "Unable to start the stub server\n");
+        return 1;
+    }
+
+    checkConcurrencyLimit();
+    checkPriorityOrder();
+    checkBlockingSkipsLimit();
+    checkConnectionReuse();
+
+    return s_failed ? 1 : 0;
+}
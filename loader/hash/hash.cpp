@@ -7,6 +7,8 @@
 #include <fstream>
 #include <ciso646>
 #include "picosha2.h"
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 template <class Func>
@@ -41,17 +43,37 @@ std::string calculateSHA256(ghc::filesystem::path const& path) {
 
 std::string calculateSHA256Text(ghc::filesystem::path const& path) {
     // remove all newlines
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
+    // the file is opened in text mode so line endings are normalized the
+    // same way std::getline would see them
     std::ifstream file(path);
-    std::string text;
-    std::string line;
-    while (std::getline(file, line)) {
-        text += line;
-    }
-    picosha2::hash256(text.begin(), text.end(), hash.begin(), hash.end());
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
+    picosha2::hash256_one_by_one hasher;
+    std::vector<uint8_t> stripped;
+    readBuffered(file, [&](const uint8_t* data, size_t amt) {
+        stripped.clear();
+        std::copy_if(data, data + amt, std::back_inserter(stripped), [](uint8_t c) {
+            return c != '\n';
+        });
+        hasher.process(stripped.begin(), stripped.end());
+    });
+    hasher.finish();
+    return picosha2::get_hash_hex_string(hasher);
 }
 
 std::string calculateHash(ghc::filesystem::path const& path) {
     return calculateSHA3_256(path);
+}
+
+HashCalculator::HashCalculator() : m_sha(std::make_unique<SHA3>()) {}
+HashCalculator::~HashCalculator() = default;
+
+void HashCalculator::add(void const* data, size_t size) {
+    m_sha->add(data, size);
+}
+
+std::string HashCalculator::getHash() {
+    return m_sha->getHash();
+}
+
+void HashCalculator::reset() {
+    m_sha->reset();
 }
\ No newline at end of file
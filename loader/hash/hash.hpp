@@ -1,8 +1,11 @@
 #pragma once
 
 #include <string>
+#include <memory>
 #include <ghc/fs_fwd.hpp>
 
+class SHA3;
+
 std::string calculateSHA3_256(ghc::filesystem::path const& path);
 
 std::string calculateSHA256(ghc::filesystem::path const& path);
@@ -10,3 +13,20 @@ std::string calculateSHA256(ghc::filesystem::path const& path);
 std::string calculateSHA256Text(ghc::filesystem::path const& path);
 
 std::string calculateHash(ghc::filesystem::path const& path);
+
+/**
+ * Calculates the same hash as calculateHash, but from data that is fed to it
+ * piece by piece
+ */
+class HashCalculator final {
+private:
+    std::unique_ptr<SHA3> m_sha;
+
+public:
+    HashCalculator();
+    ~HashCalculator();
+
+    void add(void const* data, size_t size);
+    std::string getHash();
+    void reset();
+};
@@ -9,17 +9,60 @@
 namespace geode {
     // Mod interoperability
 
+    /**
+     * All dispatch pools by ID. Prefer DispatchChannel, which looks the pool
+     * up under a lock, over accessing this map directly. Mods built against
+     * older headers still add to it without the lock
+     */
     GEODE_DLL std::unordered_map<std::string, EventListenerPool*>& dispatchPools();
 
+    /**
+     * A dispatch ID resolved to its listener pool. Resolving is thread-safe
+     * and the pool lives for the rest of the game, so a channel can be created
+     * once (for example as a static) and used with DispatchChannelEvent and
+     * DispatchChannelFilter without any further lookups
+     */
+    class GEODE_DLL DispatchChannel {
+    protected:
+        std::string const* m_id;
+        EventListenerPool* m_pool;
+
+    public:
+        explicit DispatchChannel(std::string const& id);
+
+        std::string const& getID() const {
+            return *m_id;
+        }
+
+        EventListenerPool* getPool() const {
+            return m_pool;
+        }
+
+        bool operator==(DispatchChannel const& other) const {
+            return m_pool == other.m_pool;
+        }
+    };
+
+    template <class... Args>
+    class DispatchFilter;
+
+    template <class... Args>
+    class DispatchChannelFilter;
+
+    // Events and filters are shared between mods built against different
+    // versions of this header, so their members have to stay as they are
     template <class... Args>
     class DispatchEvent : public Event {
     protected:
         std::string m_id;
         std::tuple<Args...> m_args;
+
+        friend class DispatchFilter<Args...>;
+        friend class DispatchChannelFilter<Args...>;
     
     public:
         DispatchEvent(std::string const& id, Args... args)
-          : m_id(id), m_args(std::make_tuple(args...)) {}
+          : m_id(id), m_args(std::move(args)...) {}
         
         std::tuple<Args...> getArgs() const {
             return m_args;
@@ -30,10 +73,7 @@ namespace geode {
         }
 
         EventListenerPool* getPool() const override {
-            if (dispatchPools().count(m_id) == 0) {
-                dispatchPools()[m_id] = new DefaultEventListenerPool();
-            }
-            return dispatchPools()[m_id];
+            return DispatchChannel(m_id).getPool();
         }
     };
 
@@ -47,15 +87,12 @@ namespace geode {
         using Callback = ListenerResult(Args...);
 
         EventListenerPool* getPool() const {
-            if (dispatchPools().count(m_id) == 0) {
-                dispatchPools()[m_id] = new DefaultEventListenerPool();
-            }
-            return dispatchPools()[m_id];
+            return DispatchChannel(m_id).getPool();
         }
 
         ListenerResult handle(utils::MiniFunction<Callback> fn, Ev* event) {
-            if (event->getID() == m_id) {
-                return std::apply(fn, event->getArgs());
+            if (event->m_id == m_id) {
+                return std::apply(fn, event->m_args);
             }
             return ListenerResult::Propagate;
         }
@@ -63,4 +100,51 @@ namespace geode {
         DispatchFilter(std::string const& id) : m_id(id) {}
         DispatchFilter(DispatchFilter const&) = default;
     };
+
+    /**
+     * A DispatchEvent that goes straight to its channel's pool when posted,
+     * instead of looking its ID up again. Every filter for DispatchEvent
+     * receives it, including ones in mods built against older headers
+     */
+    template <class... Args>
+    class DispatchChannelEvent : public DispatchEvent<Args...> {
+    protected:
+        EventListenerPool* m_pool;
+
+    public:
+        DispatchChannelEvent(DispatchChannel const& channel, Args... args)
+          : DispatchEvent<Args...>(channel.getID(), std::move(args)...),
+            m_pool(channel.getPool()) {}
+
+        EventListenerPool* getPool() const override {
+            return m_pool;
+        }
+    };
+
+    /**
+     * A DispatchFilter that keeps its channel's pool. Receives both
+     * DispatchEvent and DispatchChannelEvent
+     */
+    template <class... Args>
+    class DispatchChannelFilter : public EventFilter<DispatchEvent<Args...>> {
+    protected:
+        DispatchChannel m_channel;
+
+    public:
+        using Ev = DispatchEvent<Args...>;
+        using Callback = ListenerResult(Args...);
+
+        EventListenerPool* getPool() const {
+            return m_channel.getPool();
+        }
+
+        ListenerResult handle(utils::MiniFunction<Callback> fn, Ev* event) {
+            // only events for this channel's ID are posted to its pool, so
+            // the ID doesn't need comparing
+            return std::apply(fn, event->m_args);
+        }
+
+        DispatchChannelFilter(DispatchChannel const& channel) : m_channel(channel) {}
+        DispatchChannelFilter(DispatchChannelFilter const&) = default;
+    };
 }
\ No newline at end of file
@@ -118,6 +118,16 @@ namespace geode {
          */
         [[nodiscard]] matjson::Value getRuntimeInfo() const;
 
+        /**
+         * Set the detour used in place of the regular one while hook
+         * profiling is enabled. It should record the call with a
+         * `geode::hook::ProfileScope` using the slot `geode::hook::getProfileSlot`
+         * gives for the regular detour and then call it
+         * @param detour Profiled detour, or nullptr to never profile this hook
+         * @note Hooks created through $modify set this automatically
+         */
+        void setProfiledDetour(void* detour);
+
         /**
          * Get the metadata of the hook.
          * @returns Hook metadata
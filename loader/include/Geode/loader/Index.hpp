@@ -115,6 +115,13 @@ namespace geode {
          * Returns the path to the specific version
          */
         ghc::filesystem::path getPath() const;
+        /**
+         * Returns the metadata of this version, including its about and
+         * changelog files
+         * @note The about and changelog files are read the first time this
+         * is called, from disk or from the index archive, on the calling
+         * thread. If that fails they are tried again on the next call
+         */
         ModMetadata getMetadata() const;
         std::string getDownloadURL() const;
         std::string getPackageHash() const;
@@ -122,6 +129,12 @@ namespace geode {
         bool isFeatured() const;
         std::unordered_set<std::string> getTags() const;
         bool isInstalled() const;
+        /**
+         * Read a file from the directory that contains all the versions of
+         * this item, for example "logo.png". Works both when the index has
+         * been extracted and when it is read straight from its archive
+         */
+        Result<ByteVector> readFile(ghc::filesystem::path const& name) const;
 
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
         void setMetadata(ModMetadata const& value);
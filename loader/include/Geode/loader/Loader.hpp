@@ -12,6 +12,7 @@
 #include <matjson.hpp>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string_view>
 
 namespace geode {
@@ -91,6 +92,12 @@ namespace geode {
         bool isModLoaded(std::string const& id) const;
         Mod* getLoadedMod(std::string const& id) const;
         std::vector<Mod*> getAllMods();
+        /**
+         * Returns all mods in the order they were added without copying them.
+         * The span is invalidated when the mod list changes, for example when
+         * mods are refreshed, so don't hold on to it
+         */
+        std::span<Mod* const> getAllModsView() const;
         std::vector<LoadProblem> getProblems() const;
 
         /**
@@ -2,6 +2,7 @@
 
 #include <Geode/platform/platform.hpp>
 #include <tulip/TulipHook.hpp>
+#include <cstdint>
 
 namespace geode::hook {
     /**
@@ -18,4 +19,52 @@ namespace geode::hook {
     GEODE_DLL std::shared_ptr<tulip::hook::CallingConvention> createConvention(
         tulip::hook::TulipConvention convention
     ) noexcept;
+
+    /**
+     * Check whether hook profiling is enabled. While enabled, hooks that
+     * have a profiled detour (all hooks created through $modify) record
+     * their call count and time spent
+     */
+    GEODE_DLL bool isProfilingEnabled() noexcept;
+
+    /**
+     * Enable or disable hook profiling. Already enabled hooks are
+     * re-registered with the matching detour, so when profiling is
+     * disabled hooks run without any profiling overhead
+     * @note Should only be called from the main thread
+     */
+    GEODE_DLL void setProfilingEnabled(bool enabled);
+
+    /**
+     * Get the hook profiler's counter slot for a detour. Profiled detours
+     * should look this up once and keep it, so recording a call doesn't
+     * need to look the detour up again
+     * @param detour The unprofiled detour of the hook, used to match
+     * the recorded counters back to the hook
+     */
+    GEODE_DLL size_t getProfileSlot(void* detour);
+
+    /**
+     * RAII helper that records a single detour call for the hook profiler.
+     * Time spent in nested detours is tracked separately so that a detour's
+     * self time does not include the detours of other mods it calls into.
+     * Calls are recorded into a buffer owned by the calling thread, without
+     * locking
+     */
+    class GEODE_DLL ProfileScope final {
+    private:
+        size_t m_slot;
+        int64_t m_start;
+        int64_t m_parentChildTime;
+
+    public:
+        /**
+         * @param slot The hook's slot, from getProfileSlot
+         */
+        explicit ProfileScope(size_t slot) noexcept;
+        ~ProfileScope() noexcept;
+
+        ProfileScope(ProfileScope const&) = delete;
+        ProfileScope& operator=(ProfileScope const&) = delete;
+    };
 }
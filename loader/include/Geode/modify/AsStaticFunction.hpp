@@ -2,6 +2,7 @@
 #include "../utils/addresser.hpp"
 #include "Traits.hpp"
 #include "../loader/Log.hpp"
+#include "../loader/Tulip.hpp"
 
 namespace geode::modifier {
 /**
@@ -17,6 +18,12 @@ namespace geode::modifier {
             static Return GEODE_CDECL_CALL function(Params... params) {                           \
                 return Class2::FunctionName_(params...);                                          \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL profiled(Params... params) {                           \
+                static auto const slot =                                                          \
+                    geode::hook::getProfileSlot(reinterpret_cast<void*>(&function));              \
+                geode::hook::ProfileScope scope(slot);                                            \
+                return function(params...);                                                       \
+            }                                                                                     \
         };                                                                                        \
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...)> {                                               \
@@ -26,6 +33,12 @@ namespace geode::modifier {
                 );                                                                                \
                 return self2->Class2::FunctionName_(params...);                                   \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL profiled(Class* self, Params... params) {              \
+                static auto const slot =                                                          \
+                    geode::hook::getProfileSlot(reinterpret_cast<void*>(&function));              \
+                geode::hook::ProfileScope scope(slot);                                            \
+                return function(self, params...);                                                 \
+            }                                                                                     \
         };                                                                                        \
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...) const> {                                         \
@@ -35,8 +48,15 @@ namespace geode::modifier {
                 );                                                                                \
                 return self2->Class2::FunctionName_(params...);                                   \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL profiled(Class const* self, Params... params) {        \
+                static auto const slot =                                                          \
+                    geode::hook::getProfileSlot(reinterpret_cast<void*>(&function));              \
+                geode::hook::ProfileScope scope(slot);                                            \
+                return function(self, params...);                                                 \
+            }                                                                                     \
         };                                                                                        \
         static constexpr auto value = &Impl<FunctionType>::function;                              \
+        static constexpr auto profiledValue = &Impl<FunctionType>::profiled;                      \
     };
 
     GEODE_AS_STATIC_FUNCTION(constructor)
@@ -38,6 +38,11 @@
                 #ClassName_ "::" #FunctionName_,                                                              \
                 tulip::hook::TulipConvention::Convention_                                                     \
             );                                                                                                \
+            hook->setProfiledDetour(reinterpret_cast<void*>(                                                  \
+                AsStaticFunction_##FunctionName_<                                                             \
+                    Derived,                                                                                  \
+                    DerivedFuncType>::profiledValue                                                           \
+            ));                                                                                               \
             this->m_hooks[#ClassName_ "::" #FunctionName_] = hook;                                            \
         }                                                                                                     \
     } while (0);
@@ -54,6 +59,12 @@
                 #ClassName_ "::" #ClassName_,                                             \
                 tulip::hook::TulipConvention::Convention_                                 \
             );                                                                            \
+            hook->setProfiledDetour(reinterpret_cast<void*>(                              \
+                AsStaticFunction_##constructor<                                           \
+                    Derived,                                                              \
+                    decltype(Resolve<__VA_ARGS__>::func(&Derived::constructor))>          \
+                    ::profiledValue                                                       \
+            ));                                                                           \
             this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                           \
         }                                                                                 \
     } while (0);
@@ -68,6 +79,10 @@
                 #ClassName_ "::" #ClassName_,                                                                    \
                 tulip::hook::TulipConvention::Convention_                                                        \
             );                                                                                                   \
+            hook->setProfiledDetour(reinterpret_cast<void*>(                                                     \
+                AsStaticFunction_##destructor<Derived, decltype(Resolve<>::func(&Derived::destructor))>          \
+                    ::profiledValue                                                                              \
+            ));                                                                                                  \
             this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                                                  \
         }                                                                                                        \
     } while (0);
@@ -32,6 +32,11 @@ namespace geode {
 
         static cocos2d::CCSprite* createIcon(NotificationIcon icon);
 
+        bool isSameAs(Notification* other);
+        static Notification* findPending(Notification* notification);
+        static void dropOverflow();
+        static void collapseQueue();
+
         void animateIn();
         void animateOut();
         void showNextNotification();
@@ -72,6 +77,15 @@ namespace geode {
         void setIcon(cocos2d::CCSprite* icon);
         void setTime(float time);
 
+        /**
+         * Collapse bursts of notifications. If more than `threshold`
+         * notifications are waiting when the next one is shown, the ones that
+         * hide on their own are merged into a single notification that says
+         * how many there were. Notifications shown indefinitely are never
+         * merged. Pass 0 to disable, which is the default
+         */
+        static void setBurstThreshold(size_t threshold);
+
         /**
          * Set the wait time to default, wait the time and hide the notification. 
          * Equivalent to setTime(NOTIFICATION_DEFAULT_TIME)
@@ -82,7 +96,9 @@ namespace geode {
          * Adds the notification to the current scene if it doesn't have a 
          * parent yet, and displays the show animation. If the time for the 
          * notification was specified, the notification waits that time and 
-         * then automatically hides
+         * then automatically hides. If an identical notification is already 
+         * waiting to be shown, this one is dropped. If too many are waiting, 
+         * the oldest one that would hide on its own is dropped
         */
         void show();
 
@@ -96,6 +96,13 @@ namespace geode {
             JsonChecker& checker, matjson::Value& json, std::string const& hierarchy, bool hasValue
         );
 
+        /**
+         * The path to this value in the checked document, for error messages.
+         * Only worked out when this is called; m_hierarchy is just the name
+         * given to the root
+         */
+        std::string hierarchy() const;
+
         bool isError() const;
         std::string getError() const;
 
@@ -116,7 +123,7 @@ namespace geode {
             if (this->isError()) return *this;
             if (!jsonConvertibleTo(self().m_json.type(), T)) {
                 this->setError(
-                    self().m_hierarchy + ": Invalid type \"" + jsonValueTypeToString(self().m_json.type()) +
+                    self().hierarchy() + ": Invalid type \"" + jsonValueTypeToString(self().m_json.type()) +
                     "\", expected \"" + jsonValueTypeToString(T) + "\""
                 );
             }
@@ -132,7 +139,7 @@ namespace geode {
             bool isOneOf = (... || jsonConvertibleTo(self().m_json.type(), T));
             if (!isOneOf) {
                 this->setError(
-                    self().m_hierarchy + ": Invalid type \"" + jsonValueTypeToString(self().m_json.type()) +
+                    self().hierarchy() + ": Invalid type \"" + jsonValueTypeToString(self().m_json.type()) +
                     "\", expected one of \"" + (jsonValueTypeToString(T), ...) + "\""
                 );
             }
@@ -151,12 +158,12 @@ namespace geode {
             if (this->isError()) return *this;
             if (self().m_json.template is<T>()) {
                 if (!validator(self().m_json.template as<T>())) {
-                    this->setError(self().m_hierarchy + ": Invalid value format");
+                    this->setError(self().hierarchy() + ": Invalid value format");
                 }
             }
             else {
                 this->setError(
-                    self().m_hierarchy + ": Invalid type \"" +
+                    self().hierarchy() + ": Invalid type \"" +
                     std::string(jsonValueTypeToString(self().m_json.type())) + "\""
                 );
             }
@@ -197,13 +204,13 @@ namespace geode {
                 }
                 catch(matjson::JsonException const& e) {
                     this->setError(
-                        self().m_hierarchy + ": Error parsing JSON: " + std::string(e.what())
+                        self().hierarchy() + ": Error parsing JSON: " + std::string(e.what())
                     );
                 }
             }
             else {
                 this->setError(
-                    self().m_hierarchy + ": Invalid type \"" +
+                    self().hierarchy() + ": Invalid type \"" +
                     std::string(jsonValueTypeToString(self().m_json.type())) + "\""
                 );
             }
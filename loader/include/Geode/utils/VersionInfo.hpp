@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../DefaultInclude.hpp"
+#include <algorithm>
 #include <string_view>
 #include <matjson.hpp>
 #include <tuple>
@@ -163,32 +164,68 @@ namespace geode {
             return m_tag;
         }
 
+        /**
+         * Whether this version fits in getOrderingKey(); true unless a part of
+         * it is absurdly large (above 65535, or 16382 for the tag number)
+         */
+        constexpr bool hasOrderingKey() const {
+            return m_major <= 0xffff && m_minor <= 0xffff && m_patch <= 0xffff &&
+                (!m_tag || !m_tag->number || *m_tag->number < 0x3fff);
+        }
+
+        /**
+         * Get a key that orders versions the same way the comparison operators
+         * do, packed into one integer for cheap sorting and lookups: 16 bits
+         * each for the major, minor and patch versions and the tag. Only exact
+         * if hasOrderingKey() is true
+         */
+        constexpr uint64_t getOrderingKey() const {
+            // untagged versions come after any tag, and untagged numbers
+            // after any number, matching VersionTag's operators
+            uint64_t tag = 0xffff;
+            if (m_tag) {
+                tag = (static_cast<uint64_t>(m_tag->value) << 14) |
+                    (m_tag->number ? std::min<uint64_t>(*m_tag->number, 0x3ffe) : 0x3fff);
+            }
+            return (std::min<uint64_t>(m_major, 0xffff) << 48) |
+                (std::min<uint64_t>(m_minor, 0xffff) << 32) |
+                (std::min<uint64_t>(m_patch, 0xffff) << 16) |
+                tag;
+        }
+
         // Apple clang does not support operator<=>! Yippee!
 
         constexpr bool operator==(VersionInfo const& other) const {
-            return std::tie(m_major, m_minor, m_patch, m_tag) ==
-                std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
+            return this->compare(other) == 0;
         }
         constexpr bool operator<(VersionInfo const& other) const {
-            return std::tie(m_major, m_minor, m_patch, m_tag) <
-                std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
+            return this->compare(other) < 0;
         }
         constexpr bool operator<=(VersionInfo const& other) const {
-            return std::tie(m_major, m_minor, m_patch, m_tag) <=
-                std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
+            return this->compare(other) <= 0;
         }
         constexpr bool operator>(VersionInfo const& other) const {
-            return std::tie(m_major, m_minor, m_patch, m_tag) >
-                std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
+            return this->compare(other) > 0;
         }
         constexpr bool operator>=(VersionInfo const& other) const {
-            return std::tie(m_major, m_minor, m_patch, m_tag) >=
-                std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
+            return this->compare(other) >= 0;
         }
 
         std::string toString(bool includeTag = true) const;
 
         friend GEODE_DLL std::string format_as(VersionInfo const& version);
+
+    private:
+        constexpr int compare(VersionInfo const& other) const {
+            if (this->hasOrderingKey() && other.hasOrderingKey()) {
+                auto a = this->getOrderingKey();
+                auto b = other.getOrderingKey();
+                return a < b ? -1 : (a > b ? 1 : 0);
+            }
+            auto a = std::tie(m_major, m_minor, m_patch, m_tag);
+            auto b = std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
+            return a < b ? -1 : (a == b ? 0 : 1);
+        }
     };
 
     class GEODE_DLL ComparableVersionInfo final {
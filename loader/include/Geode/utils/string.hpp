@@ -2,7 +2,9 @@
 
 #include <Geode/DefaultInclude.hpp>
 #include <functional>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace geode::utils::string {
@@ -88,6 +90,117 @@ namespace geode::utils::string {
     GEODE_DLL std::string normalize(std::string const& str);
     GEODE_DLL std::wstring normalize(std::wstring const& str);
 
+    /**
+     * Find the first occurrence of a substring, starting at `from`. Uses SIMD
+     * where available
+     * @returns The position of the substring, or std::string_view::npos
+     */
+    GEODE_DLL size_t find(std::string_view str, std::string_view subs, size_t from = 0);
+    GEODE_DLL size_t find(std::string_view str, char c, size_t from = 0);
+
+    /**
+     * Trim whitespace from a string without copying it. The returned view
+     * points into `str`
+     */
+    GEODE_DLL std::string_view trimLeftView(std::string_view str);
+    GEODE_DLL std::string_view trimRightView(std::string_view str);
+    GEODE_DLL std::string_view trimView(std::string_view str);
+
+    /**
+     * A lazy range over the parts of a string between separators. The parts
+     * are views into the original string, so it has to outlive the range.
+     * Like `split`, an empty string has no parts
+     */
+    class SplitView final {
+        std::string_view m_str;
+        std::string_view m_separator;
+
+    public:
+        class Iterator final {
+            std::string_view m_rest;
+            std::string_view m_separator;
+            std::string_view m_current;
+            bool m_done = true;
+
+            void next() {
+                if (m_rest.data() == nullptr) {
+                    m_done = true;
+                    return;
+                }
+                auto pos = m_separator.empty() ?
+                    std::string_view::npos :
+                    utils::string::find(m_rest, m_separator);
+                if (pos == std::string_view::npos) {
+                    m_current = m_rest;
+                    // the last part has been reached
+                    m_rest = std::string_view();
+                }
+                else {
+                    m_current = m_rest.substr(0, pos);
+                    m_rest = m_rest.substr(pos + m_separator.size());
+                }
+                m_done = false;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::string_view const*;
+            using reference = std::string_view const&;
+
+            Iterator() = default;
+            Iterator(std::string_view str, std::string_view separator)
+              : m_rest(str), m_separator(separator) {
+                this->next();
+            }
+
+            reference operator*() const {
+                return m_current;
+            }
+            pointer operator->() const {
+                return &m_current;
+            }
+            Iterator& operator++() {
+                this->next();
+                return *this;
+            }
+            Iterator operator++(int) {
+                auto copy = *this;
+                this->next();
+                return copy;
+            }
+            bool operator==(Iterator const& other) const {
+                if (m_done || other.m_done) {
+                    return m_done == other.m_done;
+                }
+                return m_current.data() == other.m_current.data() &&
+                    m_current.size() == other.m_current.size();
+            }
+            bool operator!=(Iterator const& other) const {
+                return !(*this == other);
+            }
+        };
+
+        SplitView(std::string_view str, std::string_view separator)
+          : m_str(str), m_separator(separator) {}
+
+        Iterator begin() const {
+            if (m_str.empty()) return Iterator();
+            return Iterator(m_str, m_separator);
+        }
+        Iterator end() const {
+            return Iterator();
+        }
+    };
+
+    /**
+     * Split a string without allocating. See SplitView
+     */
+    inline SplitView splitView(std::string_view str, std::string_view separator) {
+        return SplitView(str, separator);
+    }
+
     GEODE_DLL bool startsWith(std::string const& str, std::string const& prefix);
     GEODE_DLL bool startsWith(std::wstring const& str, std::wstring const& prefix);
     GEODE_DLL bool endsWith(std::string const& str, std::string const& suffix);
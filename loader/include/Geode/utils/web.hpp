@@ -35,7 +35,9 @@ namespace geode::utils::web {
      * @param prog Progress function; first parameter is bytes downloaded so
      * far, and second is total bytes to download. Return true to continue
      * downloading, and false to interrupt. Note that interrupting does not
-     * automatically remove the file that was being downloaded
+     * automatically remove the file that was being downloaded. The
+     * progress function is called on the thread that called fetchFile,
+     * while it waits for the download
      * @returns Returned data as JSON, or error on error
      */
     GEODE_DLL Result<> fetchFile(
@@ -60,6 +62,7 @@ namespace geode::utils::web {
     using AsyncExpectCode = utils::MiniFunction<void(std::string const&, int)>;
     using AsyncThen = utils::MiniFunction<void(SentAsyncWebRequest&, ByteVector const&)>;
     using AsyncCancelled = utils::MiniFunction<void(SentAsyncWebRequest&)>;
+    using AsyncData = utils::MiniFunction<void(uint64_t, uint8_t const*, size_t)>;
 
     /**
      * A handle to an in-progress sent asynchronous web request. Use this to
@@ -225,6 +228,19 @@ namespace geode::utils::web {
          * Specify a timeout, in seconds, in which the request will fail.
          */
         AsyncWebRequest& timeout(std::chrono::seconds seconds);
+        /**
+         * Specify the priority of the request. When too many requests are
+         * running at once, queued requests with a higher priority are
+         * started first. Defaults to 0
+         */
+        AsyncWebRequest& priority(int priority);
+        /**
+         * When downloading into a file, continue from what is already in the
+         * file with a HTTP Range request instead of overwriting it. The file
+         * is also kept if the request is cancelled. If the server can't
+         * resume the download, it is started over
+         */
+        AsyncWebRequest& resumable();
 
         // Callbacks
 
@@ -259,6 +275,17 @@ namespace geode::utils::web {
          * @returns Same AsyncWebRequest
          */
         AsyncWebRequest& cancelled(AsyncCancelled handler);
+        /**
+         * Specify a callback to run with every chunk of the response body as
+         * it is received, along with its offset in the body. Unlike the other
+         * callbacks, this one is ran on the web thread and must not block.
+         * When resuming a download, the part that was already downloaded is
+         * passed first; if the download has to start over, the offset goes
+         * back to 0. Requests that join a running request don't receive data
+         * @param handler Callback to run with the received data
+         * @returns Same AsyncWebRequest
+         */
+        AsyncWebRequest& received(AsyncData handler);
     };
 
     template <class T>
@@ -27,7 +27,7 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     }
 
     void updateLoadedModsLabel() {
-        auto allMods = Loader::get()->getAllMods();
+        auto allMods = Loader::get()->getAllModsView();
         auto count = std::count_if(allMods.begin(), allMods.end(), [&](auto& item) {
             return item->isEnabled();
         });
@@ -58,7 +58,7 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
 
         NodeIDs::provideFor(this);
 
-        m_fields->m_totalMods = Loader::get()->getAllMods().size();
+        m_fields->m_totalMods = Loader::get()->getAllModsView().size();
         m_fields->m_menuDisabled = Loader::get()->getLaunchFlag("disable-custom-menu");
         if (m_fields->m_menuDisabled) {
             return true;
@@ -96,8 +96,9 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
         log::debug("Verifying Loader Resources");
         this->setSmallText("Verifying Loader Resources");
         // verify loader resources
-        Loader::get()->queueInMainThread([&]() {
-            if (!updater::verifyLoaderResources()) {
+        // this runs in the background so the loading screen keeps updating
+        updater::verifyLoaderResources([this](bool verified) {
+            if (!verified) {
                 log::debug("Downloading Loader Resources");
                 this->setSmallText("Downloading Loader Resources");
                 this->addChild(EventListenerNode<updater::ResourceDownloadFilter>::create(
@@ -145,19 +146,26 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     void setupModResources() {
         log::debug("Loading mod resources");
         this->setSmallText("Loading mod resources");
-        LoaderImpl::get()->updateResources(true);
-        this->continueLoadAssets();
+        LoaderImpl::get()->updateResourcesAsync(
+            true,
+            [this](size_t loaded, size_t total) {
+                this->setSmallText(fmt::format("Loading mod resources ({}/{})", loaded, total));
+            },
+            [this]() {
+                this->continueLoadAssets();
+            }
+        );
     }
 
     int getLoadedMods() {
-        auto allMods = Loader::get()->getAllMods();
+        auto allMods = Loader::get()->getAllModsView();
         return std::count_if(allMods.begin(), allMods.end(), [&](auto& item) {
             return item->isEnabled();
         });
     }
 
     int getEnabledMods() {
-        auto allMods = Loader::get()->getAllMods();
+        auto allMods = Loader::get()->getAllModsView();
         return std::count_if(allMods.begin(), allMods.end(), [&](auto& item) {
             return item->shouldLoad();
         });
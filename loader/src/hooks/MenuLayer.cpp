@@ -192,7 +192,7 @@ struct CustomMenuLayer : Modify<CustomMenuLayer, MenuLayer> {
 
         this->addUpdateIndicator();
 
-        for (auto mod : Loader::get()->getAllMods()) {
+        for (auto mod : Loader::get()->getAllModsView()) {
             if (mod->getMetadata().usesDeprecatedIDForm()) {
                 log::error(
                     "Mod ID '{}' will be rejected in the future - "
@@ -1,4 +1,5 @@
 #include <loader/LoaderImpl.hpp>
+#include <loader/HookProfiler.hpp>
 
 using namespace geode::prelude;
 
@@ -7,6 +8,9 @@ using namespace geode::prelude;
 struct FunctionQueue : Modify<FunctionQueue, CCScheduler> {
     void update(float dt) {
         LoaderImpl::get()->executeMainThreadQueue();
+        if (HookProfiler::get()->isEnabled()) {
+            HookProfiler::get()->merge();
+        }
         return CCScheduler::update(dt);
     }
 };
@@ -23,7 +23,7 @@ void crashlog::printGeodeInfo(std::stringstream& stream) {
     stream << "Loader Version: " << Loader::get()->getVersion().toString() << "\n"
            << "Loader Commit: " << about::getLoaderCommitHash() << "\n"
            << "Bindings Commit: " << about::getBindingsCommitHash() << "\n"
-           << "Installed mods: " << Loader::get()->getAllMods().size() << "\n"
+           << "Installed mods: " << Loader::get()->getAllModsView().size() << "\n"
            << "Problems: " << Loader::get()->getProblems().size() << "\n";
 }
 
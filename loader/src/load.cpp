@@ -1,4 +1,5 @@
 #include <loader/LoaderImpl.hpp>
+#include <loader/HookProfiler.hpp>
 #include <loader/console.hpp>
 #include <loader/IPC.hpp>
 #include <loader/updater.hpp>
@@ -43,12 +44,37 @@ $execute {
             );
         }
 
-        for (auto& mod : Loader::get()->getAllMods()) {
+        for (auto& mod : Loader::get()->getAllModsView()) {
             res.push_back(includeRunTimeInfo ? mod->getRuntimeInfo() : mod->getMetadata().toJSON());
         }
 
         return res;
     });
+
+    ipc::listen("hook-profile", [](ipc::IPCEvent* event) -> matjson::Value {
+        auto args = *event->messageData;
+        JsonChecker checker(args);
+        auto root = checker.root("[ipc/hook-profile]").obj();
+
+        std::optional<bool> enable;
+        root.has("enable").into(enable);
+        if (enable) {
+            hook::setProfilingEnabled(enable.value());
+        }
+        auto reset = root.has("reset").template get<bool>();
+        if (reset) {
+            HookProfiler::get()->reset();
+        }
+
+        auto res = matjson::Object();
+        res["enabled"] = hook::isProfilingEnabled();
+        res["mods"] = HookProfiler::get()->getReport();
+        return res;
+    });
+
+    listenForSettingChanges("enable-hook-profiler", +[](bool value) {
+        hook::setProfilingEnabled(value);
+    });
 }
 
 void tryLogForwardCompat() {
@@ -141,6 +167,12 @@ int geodeEntry(void* platformData) {
 
     tryShowForwardCompat();
 
+    // enable profiling before any mod hooks are enabled so they are
+    // registered with their profiled detours from the start
+    if (Mod::get()->getSettingValue<bool>("enable-hook-profiler")) {
+        hook::setProfilingEnabled(true);
+    }
+
     // open console
     if (!LoaderImpl::get()->isForwardCompatMode() &&
         Mod::get()->getSettingValue<bool>("show-platform-console")) {
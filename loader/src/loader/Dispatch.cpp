@@ -1,8 +1,24 @@
 #include <Geode/loader/Dispatch.hpp>
 
+#include <mutex>
+
 using namespace geode::prelude;
 
+static std::mutex s_poolsMutex;
+
 std::unordered_map<std::string, EventListenerPool*>& geode::dispatchPools() {
     static std::unordered_map<std::string, EventListenerPool*> pools;
     return pools;
+}
+
+DispatchChannel::DispatchChannel(std::string const& id) {
+    std::lock_guard lock(s_poolsMutex);
+    auto& pools = dispatchPools();
+    auto it = pools.find(id);
+    if (it == pools.end()) {
+        it = pools.emplace(id, new DefaultEventListenerPool()).first;
+    }
+    // map nodes never move, so the key can be shared by every channel
+    m_id = &it->first;
+    m_pool = it->second;
 }
\ No newline at end of file
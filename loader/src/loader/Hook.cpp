@@ -52,6 +52,10 @@ matjson::Value Hook::getRuntimeInfo() const {
     return m_impl->getRuntimeInfo();
 }
 
+void Hook::setProfiledDetour(void* detour) {
+    return m_impl->setProfiledDetour(detour);
+}
+
 tulip::hook::HookMetadata Hook::getHookMetadata() const {
     return m_impl->getHookMetadata();
 }
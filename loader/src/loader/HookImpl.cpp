@@ -1,6 +1,7 @@
 #include "HookImpl.hpp"
 
 #include <utility>
+#include "HookProfiler.hpp"
 #include "LoaderImpl.hpp"
 
 Hook::Impl::Impl(
@@ -66,9 +67,15 @@ Result<> Hook::Impl::enable() {
     }
 
     GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getOrCreateHandler(m_address, m_handlerMetadata));
-    m_handle = tulip::hook::createHook(handler, m_detour, m_hookMetadata);
+    auto profiled = m_profiledDetour && HookProfiler::get()->isEnabled();
+    m_activeDetour = profiled ? m_profiledDetour : m_detour;
+    m_handle = tulip::hook::createHook(handler, m_activeDetour, m_hookMetadata);
     m_enabled = true;
 
+    if (profiled) {
+        HookProfiler::get()->registerHook(m_detour, m_self);
+    }
+
     if (m_owner) {
         log::debug("Enabled {} hook at {} for {}", m_displayName, m_address, m_owner->getID());
     }
@@ -85,6 +92,7 @@ Result<> Hook::Impl::disable() {
     GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getHandler(m_address));
     tulip::hook::removeHook(handler, m_handle);
     m_enabled = false;
+    HookProfiler::get()->unregisterHook(m_detour);
     log::debug("Disabled {} hook", m_displayName);
     return Ok();
 }
@@ -103,9 +111,29 @@ matjson::Value Hook::Impl::getRuntimeInfo() const {
     json["detour"] = std::to_string(reinterpret_cast<uintptr_t>(m_detour));
     json["name"] = m_displayName;
     json["enabled"] = m_enabled;
+    if (auto profile = HookProfiler::get()->getHookInfo(m_detour)) {
+        json["profile"] = profile.value();
+    }
     return json;
 }
 
+void Hook::Impl::setProfiledDetour(void* detour) {
+    m_profiledDetour = detour;
+    auto res = this->refreshProfiling();
+    if (!res) {
+        log::error("Failed to update hook detour: {}", res.unwrapErr());
+    }
+}
+
+Result<> Hook::Impl::refreshProfiling() {
+    if (!m_enabled) return Ok();
+    auto detour = m_profiledDetour && HookProfiler::get()->isEnabled() ?
+        m_profiledDetour : m_detour;
+    if (detour == m_activeDetour) return Ok();
+    GEODE_UNWRAP(this->disable());
+    return this->enable();
+}
+
 tulip::hook::HookMetadata Hook::Impl::getHookMetadata() const {
     return m_hookMetadata;
 }
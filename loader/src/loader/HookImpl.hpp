@@ -42,6 +42,9 @@ public:
     Hook* m_self = nullptr;
     void* m_address;
     void* m_detour;
+    void* m_profiledDetour = nullptr;
+    // the detour the hook was actually registered with
+    void* m_activeDetour = nullptr;
     std::string m_displayName;
     tulip::hook::HandlerMetadata m_handlerMetadata;
     tulip::hook::HookMetadata m_hookMetadata;
@@ -53,6 +56,8 @@ public:
     uintptr_t getAddress() const;
     std::string_view getDisplayName() const;
     matjson::Value getRuntimeInfo() const;
+    void setProfiledDetour(void* detour);
+    Result<> refreshProfiling();
     tulip::hook::HookMetadata getHookMetadata() const;
     void setHookMetadata(tulip::hook::HookMetadata const& metadata);
     int32_t getPriority() const;
@@ -0,0 +1,354 @@
+#include "HookProfiler.hpp"
+
+#include <Geode/loader/Loader.hpp>
+#include <Geode/loader/Log.hpp>
+#include <Geode/loader/Tulip.hpp>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <utility>
+
+using namespace geode::prelude;
+
+static thread_local HookProfiler::ThreadBuffer* s_threadBuffer = nullptr;
+// time spent in profiled detours called from the current detour
+static thread_local int64_t s_childTime = 0;
+
+static int64_t profilerNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+static double toMicroseconds(int64_t ns) {
+    return static_cast<double>(ns) / 1000.0;
+}
+
+void HookProfileCounters::add(HookProfileCounters const& other) {
+    calls += other.calls;
+    totalTime += other.totalTime;
+    selfTime += other.selfTime;
+    maxTime = std::max(maxTime, other.maxTime);
+}
+
+matjson::Value HookProfileCounters::toJSON() const {
+    auto json = matjson::Object();
+    json["calls"] = static_cast<double>(calls);
+    json["total-us"] = toMicroseconds(totalTime);
+    json["self-us"] = toMicroseconds(selfTime);
+    json["max-us"] = toMicroseconds(maxTime);
+    return json;
+}
+
+HookProfiler* HookProfiler::get() {
+    static auto inst = new HookProfiler();
+    return inst;
+}
+
+bool HookProfiler::isEnabled() const {
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+void HookProfiler::setEnabled(bool enabled) {
+    if (m_enabled.exchange(enabled) == enabled) {
+        return;
+    }
+    log::info("{} hook profiling", enabled ? "Enabling" : "Disabling");
+
+    // re-register every hook so it uses the matching detour
+    for (auto mod : Loader::get()->getAllModsView()) {
+        for (auto hook : mod->getHooks()) {
+            if (!hook->isEnabled()) continue;
+            auto res = hook->disable();
+            if (res) {
+                res = hook->enable();
+            }
+            if (!res) {
+                log::error(
+                    "Failed to re-enable hook {} for {}: {}",
+                    hook->getDisplayName(), mod->getID(), res.unwrapErr()
+                );
+            }
+        }
+    }
+    if (enabled) {
+        this->reset();
+    }
+}
+
+HookProfiler::ThreadSlot& HookProfiler::ThreadBuffer::at(size_t slot) {
+    auto& chunk = chunks[slot / SLOTS_PER_CHUNK];
+    // only the owning thread allocates its chunks
+    auto slots = chunk.load(std::memory_order_relaxed);
+    if (!slots) {
+        slots = new ThreadSlot[SLOTS_PER_CHUNK];
+        chunk.store(slots, std::memory_order_release);
+    }
+    return slots[slot % SLOTS_PER_CHUNK];
+}
+
+HookProfiler::ThreadBuffer::~ThreadBuffer() {
+    for (auto& chunk : chunks) {
+        delete[] chunk.load();
+    }
+}
+
+HookProfiler::ThreadBuffer& HookProfiler::getThreadBuffer() {
+    if (!s_threadBuffer) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        s_threadBuffer = buffer.get();
+        // the buffer outlives its thread so the counters of finished
+        // threads still end up in the totals
+        std::lock_guard lock(m_buffersMutex);
+        m_buffers.push_back(std::move(buffer));
+    }
+    return *s_threadBuffer;
+}
+
+uint32_t HookProfiler::getFrame() const {
+    return m_frame.load(std::memory_order_relaxed);
+}
+
+size_t HookProfiler::getSlot(void* detour) {
+    std::lock_guard lock(m_hooksMutex);
+    if (auto it = m_slots.find(detour); it != m_slots.end()) {
+        return it->second;
+    }
+    if (m_slots.size() >= MAX_SLOTS) {
+        static bool warned = false;
+        if (!std::exchange(warned, true)) {
+            log::warn("Out of hook profiler slots, further hooks won't be profiled");
+        }
+        return MAX_SLOTS;
+    }
+    auto slot = m_slots.size();
+    m_slots.emplace(detour, slot);
+    return slot;
+}
+
+std::optional<size_t> HookProfiler::findSlot(void* detour) const {
+    if (auto it = m_slots.find(detour); it != m_slots.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+void HookProfiler::registerHook(void* detour, Hook* hook) {
+    std::lock_guard lock(m_hooksMutex);
+    m_hooks[detour] = hook;
+}
+
+void HookProfiler::unregisterHook(void* detour) {
+    std::lock_guard lock(m_hooksMutex);
+    m_hooks.erase(detour);
+}
+
+// Calls the callback with every slot the buffer has allocated, along with
+// what the last merge saw of it
+template <class F>
+static void forEachSlot(HookProfiler::ThreadBuffer& buffer, size_t slotCount, F&& callback) {
+    buffer.merged.resize(slotCount);
+    for (size_t chunk = 0; chunk * HookProfiler::SLOTS_PER_CHUNK < slotCount; chunk++) {
+        auto slots = buffer.chunks[chunk].load(std::memory_order_acquire);
+        if (!slots) continue;
+        auto first = chunk * HookProfiler::SLOTS_PER_CHUNK;
+        auto count = std::min(HookProfiler::SLOTS_PER_CHUNK, slotCount - first);
+        for (size_t i = 0; i < count; i++) {
+            callback(first + i, slots[i], buffer.merged[first + i]);
+        }
+    }
+}
+
+void HookProfiler::merge() {
+    size_t slotCount;
+    {
+        std::lock_guard lock(m_hooksMutex);
+        slotCount = m_slots.size();
+    }
+    auto frameNumber = m_frame.load(std::memory_order_relaxed);
+
+    // The recording threads may be writing while this reads, so a call
+    // that ends mid-merge can be split between this frame and the next, and
+    // its time may be left out of the frame's max. Totals always catch up
+    std::vector<HookProfileCounters> frame(slotCount);
+    {
+        std::lock_guard lock(m_buffersMutex);
+        for (auto& buffer : m_buffers) {
+            forEachSlot(*buffer, slotCount, [&](size_t index, ThreadSlot& slot, HookProfileCounters& seen) {
+                auto calls = slot.calls.load(std::memory_order_relaxed);
+                if (calls == seen.calls) return;
+                HookProfileCounters now;
+                now.calls = calls;
+                now.totalTime = slot.totalTime.load(std::memory_order_relaxed);
+                now.selfTime = slot.selfTime.load(std::memory_order_relaxed);
+
+                HookProfileCounters added;
+                added.calls = now.calls - seen.calls;
+                added.totalTime = now.totalTime - seen.totalTime;
+                added.selfTime = now.selfTime - seen.selfTime;
+                if (slot.maxFrame.load(std::memory_order_relaxed) == frameNumber) {
+                    added.maxTime = slot.maxTime.load(std::memory_order_relaxed);
+                }
+                frame[index].add(added);
+                seen = now;
+            });
+        }
+    }
+    m_frame.store(frameNumber + 1, std::memory_order_relaxed);
+
+    std::lock_guard lock(m_resultsMutex);
+    m_totals.resize(slotCount);
+    for (size_t i = 0; i < slotCount; i++) {
+        m_totals[i].add(frame[i]);
+    }
+    m_lastFrame = std::move(frame);
+}
+
+void HookProfiler::reset() {
+    size_t slotCount;
+    {
+        std::lock_guard lock(m_hooksMutex);
+        slotCount = m_slots.size();
+    }
+    {
+        // the counters keep growing, so resetting just means the next
+        // merge only counts what was added after this
+        std::lock_guard lock(m_buffersMutex);
+        for (auto& buffer : m_buffers) {
+            forEachSlot(*buffer, slotCount, [](size_t, ThreadSlot& slot, HookProfileCounters& seen) {
+                seen.calls = slot.calls.load(std::memory_order_relaxed);
+                seen.totalTime = slot.totalTime.load(std::memory_order_relaxed);
+                seen.selfTime = slot.selfTime.load(std::memory_order_relaxed);
+            });
+        }
+    }
+    std::lock_guard lock(m_resultsMutex);
+    m_totals.clear();
+    m_lastFrame.clear();
+}
+
+matjson::Value HookProfiler::getCountersInfo(std::optional<size_t> slot) const {
+    auto json = matjson::Object();
+    json["total"] = slot && *slot < m_totals.size() ?
+        m_totals[*slot].toJSON() : HookProfileCounters().toJSON();
+    json["last-frame"] = slot && *slot < m_lastFrame.size() ?
+        m_lastFrame[*slot].toJSON() : HookProfileCounters().toJSON();
+    return json;
+}
+
+std::optional<matjson::Value> HookProfiler::getHookInfo(void* detour) const {
+    std::lock_guard hooksLock(m_hooksMutex);
+    std::lock_guard lock(m_resultsMutex);
+    auto slot = this->findSlot(detour);
+    if (!this->isEnabled() && !(slot && *slot < m_totals.size() && m_totals[*slot].calls)) {
+        return std::nullopt;
+    }
+    return this->getCountersInfo(slot);
+}
+
+std::optional<matjson::Value> HookProfiler::getModInfo(Mod* mod) const {
+    if (!this->isEnabled()) {
+        return std::nullopt;
+    }
+    HookProfileCounters total;
+    HookProfileCounters frame;
+    {
+        std::lock_guard hooksLock(m_hooksMutex);
+        std::lock_guard lock(m_resultsMutex);
+        for (auto& [detour, hook] : m_hooks) {
+            if (hook->getOwner() != mod) continue;
+            auto slot = this->findSlot(detour);
+            if (!slot) continue;
+            if (*slot < m_totals.size()) {
+                total.add(m_totals[*slot]);
+            }
+            if (*slot < m_lastFrame.size()) {
+                frame.add(m_lastFrame[*slot]);
+            }
+        }
+    }
+    auto json = matjson::Object();
+    json["total"] = total.toJSON();
+    json["last-frame"] = frame.toJSON();
+    return json;
+}
+
+matjson::Value HookProfiler::getReport() const {
+    struct ModEntry {
+        HookProfileCounters total;
+        HookProfileCounters frame;
+        matjson::Array hooks;
+    };
+    std::map<std::string, ModEntry> mods;
+    {
+        std::lock_guard hooksLock(m_hooksMutex);
+        std::lock_guard lock(m_resultsMutex);
+        for (auto& [detour, hook] : m_hooks) {
+            auto owner = hook->getOwner();
+            auto& entry = mods[owner ? owner->getID() : ""];
+            auto slot = this->findSlot(detour);
+            if (slot && *slot < m_totals.size()) {
+                entry.total.add(m_totals[*slot]);
+            }
+            if (slot && *slot < m_lastFrame.size()) {
+                entry.frame.add(m_lastFrame[*slot]);
+            }
+            auto info = this->getCountersInfo(slot);
+            info["name"] = std::string(hook->getDisplayName());
+            info["address"] = std::to_string(hook->getAddress());
+            entry.hooks.push_back(info);
+        }
+    }
+
+    auto res = matjson::Array();
+    for (auto& [id, entry] : mods) {
+        auto json = matjson::Object();
+        json["id"] = id;
+        json["total"] = entry.total.toJSON();
+        json["last-frame"] = entry.frame.toJSON();
+        json["hooks"] = entry.hooks;
+        res.push_back(json);
+    }
+    return res;
+}
+
+bool geode::hook::isProfilingEnabled() noexcept {
+    return HookProfiler::get()->isEnabled();
+}
+
+void geode::hook::setProfilingEnabled(bool enabled) {
+    HookProfiler::get()->setEnabled(enabled);
+}
+
+size_t geode::hook::getProfileSlot(void* detour) {
+    return HookProfiler::get()->getSlot(detour);
+}
+
+geode::hook::ProfileScope::ProfileScope(size_t slot) noexcept
+  : m_slot(slot), m_parentChildTime(s_childTime) {
+    s_childTime = 0;
+    m_start = profilerNow();
+}
+
+geode::hook::ProfileScope::~ProfileScope() noexcept {
+    auto elapsed = profilerNow() - m_start;
+    auto self = elapsed - s_childTime;
+    s_childTime = m_parentChildTime + elapsed;
+    if (m_slot >= HookProfiler::MAX_SLOTS) return;
+
+    auto profiler = HookProfiler::get();
+    auto& slot = profiler->getThreadBuffer().at(m_slot);
+    auto frame = profiler->getFrame();
+    // this thread is the only writer, so these don't need to be atomic
+    // increments; the merging thread only reads them
+    slot.calls.store(slot.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    slot.totalTime.store(slot.totalTime.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+    slot.selfTime.store(slot.selfTime.load(std::memory_order_relaxed) + self, std::memory_order_relaxed);
+    if (slot.maxFrame.load(std::memory_order_relaxed) != frame) {
+        slot.maxTime.store(elapsed, std::memory_order_relaxed);
+        slot.maxFrame.store(frame, std::memory_order_relaxed);
+    }
+    else if (elapsed > slot.maxTime.load(std::memory_order_relaxed)) {
+        slot.maxTime.store(elapsed, std::memory_order_relaxed);
+    }
+}
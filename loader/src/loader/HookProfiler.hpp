@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Geode/loader/Hook.hpp>
+#include <Geode/loader/Mod.hpp>
+#include <matjson.hpp>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace geode {
+    /**
+     * Counters for a single hook. Times are in nanoseconds; total time
+     * includes the detours and original function called from the detour,
+     * self time does not include other profiled detours
+     */
+    struct HookProfileCounters final {
+        uint64_t calls = 0;
+        int64_t totalTime = 0;
+        int64_t selfTime = 0;
+        int64_t maxTime = 0;
+
+        void add(HookProfileCounters const& other);
+        matjson::Value toJSON() const;
+    };
+
+    class HookProfiler final {
+    public:
+        static constexpr size_t SLOTS_PER_CHUNK = 256;
+        static constexpr size_t MAX_CHUNKS = 64;
+        static constexpr size_t MAX_SLOTS = SLOTS_PER_CHUNK * MAX_CHUNKS;
+
+        /**
+         * Counters of one hook on one thread. Only the owning thread writes
+         * them, with plain relaxed stores, so recording a call never locks.
+         * They only ever grow; merge() works out what was added since the
+         * last frame
+         */
+        struct ThreadSlot final {
+            std::atomic<uint64_t> calls = 0;
+            std::atomic<int64_t> totalTime = 0;
+            std::atomic<int64_t> selfTime = 0;
+            // longest call in the frame numbered maxFrame
+            std::atomic<int64_t> maxTime = 0;
+            std::atomic<uint32_t> maxFrame = 0;
+        };
+
+        /**
+         * Counters recorded by a single thread, indexed by the hook's slot.
+         * Chunks are allocated by the owning thread the first time it hits
+         * a hook in them
+         */
+        struct ThreadBuffer final {
+            std::array<std::atomic<ThreadSlot*>, MAX_CHUNKS> chunks {};
+            // the counters as of the last merge, only used while merging
+            std::vector<HookProfileCounters> merged;
+
+            ThreadSlot& at(size_t slot);
+            ~ThreadBuffer();
+        };
+
+    private:
+        std::atomic_bool m_enabled = false;
+        // numbers the frames so each thread can tell when to restart its
+        // per-frame max
+        std::atomic<uint32_t> m_frame = 0;
+
+        std::mutex m_buffersMutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+        mutable std::mutex m_hooksMutex;
+        std::unordered_map<void*, Hook*> m_hooks;
+        // slots are handed out once per detour and never reused
+        std::unordered_map<void*, size_t> m_slots;
+
+        // merged counters, indexed by slot
+        mutable std::mutex m_resultsMutex;
+        std::vector<HookProfileCounters> m_totals;
+        std::vector<HookProfileCounters> m_lastFrame;
+
+        std::optional<size_t> findSlot(void* detour) const;
+        matjson::Value getCountersInfo(std::optional<size_t> slot) const;
+
+    public:
+        static HookProfiler* get();
+
+        bool isEnabled() const;
+        void setEnabled(bool enabled);
+
+        ThreadBuffer& getThreadBuffer();
+        uint32_t getFrame() const;
+
+        /**
+         * Get the counter slot of a detour, assigning one on first use
+         * @returns The slot, or MAX_SLOTS if every slot is taken
+         */
+        size_t getSlot(void* detour);
+
+        void registerHook(void* detour, Hook* hook);
+        void unregisterHook(void* detour);
+
+        /**
+         * Merge the per-thread buffers into the totals. Called once per frame
+         * from the main thread
+         */
+        void merge();
+        void reset();
+
+        std::optional<matjson::Value> getHookInfo(void* detour) const;
+        std::optional<matjson::Value> getModInfo(Mod* mod) const;
+        matjson::Value getReport() const;
+    };
+}
@@ -8,7 +8,14 @@
 #include <hash/hash.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <Geode/loader/Mod.hpp>
-
+#include "ModMetadataImpl.hpp"
+#include <about.hpp>
+#include <utils/JsonSchema.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <thread>
 
 #ifdef GEODE_IS_WINDOWS
@@ -46,12 +53,164 @@ ListenerResult IndexUpdateFilter::handle(
 
 IndexUpdateFilter::IndexUpdateFilter() {}
 
+// Index storage
+
+static ghc::filesystem::path getIndexTreeDir() {
+    return dirs::getIndexDir() / "v0";
+}
+
+static ghc::filesystem::path getIndexArchivesDir() {
+    return dirs::getIndexDir() / "archives";
+}
+
+// holds the name of the archive in getIndexArchivesDir() that the index is
+// read from, when it isn't extracted
+static ghc::filesystem::path getIndexArchiveNamePath() {
+    return dirs::getIndexDir() / ".archive";
+}
+
+static std::optional<ghc::filesystem::path> getIndexArchivePath() {
+    auto name = file::readString(getIndexArchiveNamePath()).unwrapOr("");
+    if (name.empty()) {
+        return std::nullopt;
+    }
+    return getIndexArchivesDir() / name;
+}
+
+/**
+ * A downloaded index zipball, when the index is read straight from it
+ * instead of being extracted. Entries are found through the zip's central
+ * directory, and the folder GitHub puts at the root of the zipball is
+ * mapped away with a path prefix.
+ * Every index snapshot and every item in it holds on to the archive it was
+ * read from, so an update never closes an archive that's still being read.
+ * For the same reason every download is saved under a new name instead of
+ * replacing the open file
+ */
+class IndexArchive final {
+private:
+    // the zip handle keeps a read position, so only one read at a time
+    std::mutex m_mutex;
+    file::Unzip m_unzip;
+    ghc::filesystem::path m_path;
+    ghc::filesystem::path m_prefix;
+
+    IndexArchive(file::Unzip&& unzip, ghc::filesystem::path const& path, ghc::filesystem::path const& prefix)
+      : m_unzip(std::move(unzip)), m_path(path), m_prefix(prefix) {}
+
+    std::optional<ghc::filesystem::path> getEntry(ghc::filesystem::path const& path) const {
+        auto relative = path.lexically_relative(getIndexTreeDir());
+        if (relative.empty() || *relative.begin() == "..") {
+            return std::nullopt;
+        }
+        return m_prefix / relative;
+    }
+
+public:
+    static Result<std::shared_ptr<IndexArchive>> open(ghc::filesystem::path const& path) {
+        GEODE_UNWRAP_INTO(auto unzip, file::Unzip::create(path));
+        // github zipballs have a single folder at the root
+        ghc::filesystem::path prefix;
+        for (auto& entry : unzip.getEntries()) {
+            if (entry.empty()) continue;
+            auto root = *entry.begin();
+            if (prefix.empty()) {
+                prefix = root;
+            }
+            else if (prefix != root) {
+                prefix.clear();
+                break;
+            }
+        }
+        return Ok(std::shared_ptr<IndexArchive>(new IndexArchive(std::move(unzip), path, prefix)));
+    }
+
+    ghc::filesystem::path const& getPath() const {
+        return m_path;
+    }
+
+    /**
+     * Read a file in the index tree, given its path as if the index had
+     * been extracted
+     */
+    Result<ByteVector> read(ghc::filesystem::path const& path) {
+        auto entry = this->getEntry(path);
+        if (!entry) {
+            return Err("Path is not in the index");
+        }
+        std::lock_guard lock(m_mutex);
+        return m_unzip.extract(*entry);
+    }
+
+    Result<> addSpecialFiles(ModMetadata& metadata, ghc::filesystem::path const& dir) {
+        auto entry = this->getEntry(dir);
+        if (!entry) {
+            return Err("Path is not in the index");
+        }
+        std::lock_guard lock(m_mutex);
+        return ModMetadataImpl::getImpl(metadata).addSpecialFiles(m_unzip, *entry);
+    }
+};
+
+// Deletes every archive except the one named `keep`. An archive that an
+// older snapshot still has open can't be deleted on Windows, so it's left
+// for a later update to delete
+static void removeOldIndexArchives(ghc::filesystem::path const& keep) {
+    auto archives = file::readDirectory(getIndexArchivesDir()).unwrapOr(std::vector<ghc::filesystem::path>());
+    for (auto& archive : archives) {
+        if (archive.filename() == keep) continue;
+        std::error_code ec;
+        ghc::filesystem::remove(archive, ec);
+    }
+}
+
+// Reads from the archive if the index is kept as one, otherwise from the
+// extracted tree
+static Result<ByteVector> readIndexFile(IndexArchive* archive, ghc::filesystem::path const& path) {
+    if (archive) {
+        return archive->read(path);
+    }
+    return file::readBinary(path);
+}
+
+static Result<std::string> readIndexString(IndexArchive* archive, ghc::filesystem::path const& path) {
+    GEODE_UNWRAP_INTO(auto data, readIndexFile(archive, path));
+    return Ok(std::string(data.begin(), data.end()));
+}
+
+static Result<matjson::Value> readIndexJson(IndexArchive* archive, ghc::filesystem::path const& path) {
+    GEODE_UNWRAP_INTO(auto data, readIndexString(archive, path));
+    std::string error;
+    auto res = matjson::parse(data, error);
+    if (error.size() > 0) {
+        return Err("Unable to parse JSON: " + error);
+    }
+    return Ok(res.value());
+}
+
 // IndexItem
 
+/**
+ * A single item in the index catalog, which caches the parsed index tree
+ * so it doesn't have to be walked again until the index changes
+ */
+struct IndexCatalogRecord final {
+    std::string modID;
+    std::string version;
+    std::string modJSON;
+    std::string downloadURL;
+    std::string downloadHash;
+    bool isFeatured = false;
+    std::vector<PlatformID> platforms;
+    std::vector<std::string> tags;
+};
+
 class IndexItem::Impl final {
 private:
     ghc::filesystem::path m_rootPath;
     ghc::filesystem::path m_path;
+    // the archive the item was read from, if the index isn't extracted
+    std::shared_ptr<IndexArchive> m_archive;
     ModMetadata m_metadata;
     std::string m_downloadURL;
     std::string m_downloadHash;
@@ -59,17 +218,39 @@ private:
     bool m_isFeatured = false;
     bool m_isInstalled = false;
     std::unordered_set<std::string> m_tags;
+    // the markdown files are only read once someone asks for the metadata.
+    // the mutex also guards m_metadata while they are added
+    std::mutex m_specialFilesMutex;
+    bool m_specialFilesLoaded = false;
 
     friend class IndexItem;
 
+    ModMetadata getMetadataWithSpecialFiles();
+
 public:
     /**
      * Create IndexItem from a directory
      */
     static Result<std::shared_ptr<IndexItem>> create(
+        std::shared_ptr<IndexArchive> archive,
         ghc::filesystem::path const& rootDir,
         ghc::filesystem::path const& dir
     );
+    /**
+     * Create IndexItem from a record in the index catalog
+     */
+    static Result<std::shared_ptr<IndexItem>> create(
+        std::shared_ptr<IndexArchive> archive,
+        ghc::filesystem::path const& entriesRoot,
+        IndexCatalogRecord const& record
+    );
+
+    /**
+     * Metadata without the markdown files, for queries that don't need
+     * them
+     */
+    ModMetadata const& getBaseMetadata() const;
+    IndexCatalogRecord toRecord(std::string const& modID) const;
 
     bool isInstalled() const;
 };
@@ -86,7 +267,7 @@ ghc::filesystem::path IndexItem::getPath() const {
 }
 
 ModMetadata IndexItem::getMetadata() const {
-    return m_impl->m_metadata;
+    return m_impl->getMetadataWithSpecialFiles();
 }
 
 std::string IndexItem::getDownloadURL() const {
@@ -113,6 +294,10 @@ bool IndexItem::isInstalled() const {
     return m_impl->isInstalled();
 }
 
+Result<ByteVector> IndexItem::readFile(ghc::filesystem::path const& name) const {
+    return readIndexFile(m_impl->m_archive.get(), m_impl->m_rootPath / name);
+}
+
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
 void IndexItem::setMetadata(ModMetadata const& value) {
     m_impl->m_metadata = value;
@@ -143,22 +328,56 @@ void IndexItem::setIsInstalled(bool const& value) {
 }
 #endif
 
-Result<IndexItemHandle> IndexItem::Impl::create(ghc::filesystem::path const& rootDir, ghc::filesystem::path const& dir) {
+static Result<ModMetadata> createIndexMetadata(
+    ghc::filesystem::path const& path, std::string const& data
+) {
+    std::string error;
+    auto json = matjson::parse(data, error);
+    if (error.size() > 0) {
+        return Err("Unable to parse mod.json: " + error);
+    }
+    GEODE_UNWRAP_INTO(
+        auto metadata, ModMetadata::create(json.value())
+            .expect("Unable to read mod.json: {error}")
+    );
+    ModMetadataImpl::getImpl(metadata).m_path = path;
+    return Ok(metadata);
+}
+
+// entry.json has never been checked for unknown keys, so it isn't now either
+static JsonSchema const& getIndexEntrySchema() {
+    using Type = matjson::Type;
+    static auto const schema = JsonSchema::object({
+        { "platforms", JsonSchema::array(JsonSchema::of(Type::String)) },
+        { "tags", JsonSchema::array(JsonSchema::of(Type::String)) },
+        { "mod", JsonSchema::object({
+            { "download", JsonSchema::of(Type::String) },
+            { "hash", JsonSchema::of(Type::String) },
+        }, false) },
+        { "featured", JsonSchema::of(Type::Bool) },
+    }, false);
+    return schema;
+}
+
+Result<IndexItemHandle> IndexItem::Impl::create(
+    std::shared_ptr<IndexArchive> archive,
+    ghc::filesystem::path const& rootDir,
+    ghc::filesystem::path const& dir
+) {
     GEODE_UNWRAP_INTO(
-        auto entry, file::readJson(dir / "entry.json")
+        auto entry, readIndexJson(archive.get(), dir / "entry.json")
             .expect("Unable to read entry.json")
     );
     GEODE_UNWRAP_INTO(
-        auto metadata, ModMetadata::createFromFile(dir / "mod.json")
+        auto modJSON, readIndexString(archive.get(), dir / "mod.json")
             .expect("Unable to read mod.json: {error}")
     );
-    auto metadataRes = metadata.addSpecialFiles(rootDir);
-    if (!metadataRes) {
-        log::warn("Unable to add special files from {}: {}", rootDir, metadataRes.unwrapErr());
-    }
+    GEODE_UNWRAP_INTO(auto metadata, createIndexMetadata(dir / "mod.json", modJSON));
 
-    JsonChecker checker(entry);
     auto checkerRoot = fmt::format("[{}/{}/entry.json]", metadata.getID(), metadata.getVersion());
+    GEODE_UNWRAP(getIndexEntrySchema().validate(entry, checkerRoot));
+
+    JsonChecker checker(entry);
     auto root = checker.root(checkerRoot).obj();
 
     std::unordered_set<PlatformID> platforms;
@@ -174,6 +393,7 @@ Result<IndexItemHandle> IndexItem::Impl::create(ghc::filesystem::path const& roo
     auto item = std::make_shared<IndexItem>();
     item->m_impl->m_rootPath = rootDir;
     item->m_impl->m_path = dir;
+    item->m_impl->m_archive = std::move(archive);
     item->m_impl->m_metadata = metadata;
     item->m_impl->m_platforms = platforms;
     item->m_impl->m_tags = tags;
@@ -187,6 +407,72 @@ Result<IndexItemHandle> IndexItem::Impl::create(ghc::filesystem::path const& roo
     return Ok(item);
 }
 
+Result<IndexItemHandle> IndexItem::Impl::create(
+    std::shared_ptr<IndexArchive> archive,
+    ghc::filesystem::path const& entriesRoot,
+    IndexCatalogRecord const& record
+) {
+    auto rootDir = entriesRoot / record.modID;
+    auto dir = rootDir / record.version;
+    GEODE_UNWRAP_INTO(auto metadata, createIndexMetadata(dir / "mod.json", record.modJSON));
+
+    auto item = std::make_shared<IndexItem>();
+    item->m_impl->m_rootPath = rootDir;
+    item->m_impl->m_path = dir;
+    item->m_impl->m_archive = std::move(archive);
+    item->m_impl->m_metadata = metadata;
+    item->m_impl->m_platforms = { record.platforms.begin(), record.platforms.end() };
+    item->m_impl->m_tags = { record.tags.begin(), record.tags.end() };
+    item->m_impl->m_downloadURL = record.downloadURL;
+    item->m_impl->m_downloadHash = record.downloadHash;
+    item->m_impl->m_isFeatured = record.isFeatured;
+    return Ok(item);
+}
+
+ModMetadata IndexItem::Impl::getMetadataWithSpecialFiles() {
+    std::lock_guard lock(m_specialFilesMutex);
+    if (m_specialFilesLoaded) {
+        return m_metadata;
+    }
+    auto addSpecialFiles = [this](ghc::filesystem::path const& dir) {
+        if (m_archive) {
+            return m_archive->addSpecialFiles(m_metadata, dir);
+        }
+        return m_metadata.addSpecialFiles(dir);
+    };
+    // files next to the mod.json of this version, overridden by the
+    // ones shared between all versions
+    auto metadataRes = addSpecialFiles(m_path);
+    if (metadataRes) {
+        metadataRes = addSpecialFiles(m_rootPath);
+    }
+    // not marked as loaded on failure, so the next call tries again
+    if (metadataRes) {
+        m_specialFilesLoaded = true;
+    }
+    else {
+        log::warn("Unable to add special files from {}: {}", m_rootPath, metadataRes.unwrapErr());
+    }
+    return m_metadata;
+}
+
+ModMetadata const& IndexItem::Impl::getBaseMetadata() const {
+    return m_metadata;
+}
+
+IndexCatalogRecord IndexItem::Impl::toRecord(std::string const& modID) const {
+    IndexCatalogRecord record;
+    record.modID = modID;
+    record.version = m_path.filename().string();
+    record.modJSON = m_metadata.getRawJSON().dump(matjson::NO_INDENTATION);
+    record.downloadURL = m_downloadURL;
+    record.downloadHash = m_downloadHash;
+    record.isFeatured = m_isFeatured;
+    record.platforms = { m_platforms.begin(), m_platforms.end() };
+    record.tags = { m_tags.begin(), m_tags.end() };
+    return record;
+}
+
 bool IndexItem::Impl::isInstalled() const {
     if (m_isInstalled) {
         return true;
@@ -238,6 +524,141 @@ static Result<> flattenGithubRepo(ghc::filesystem::path const& dir) {
     return Ok();
 }
 
+// Index catalog
+
+static constexpr uint32_t INDEX_CATALOG_MAGIC = 0x58444947; // "GIDX"
+static constexpr uint32_t INDEX_CATALOG_VERSION = 2;
+
+static ghc::filesystem::path getIndexCatalogPath() {
+    return dirs::getIndexDir() / "catalog.bin";
+}
+
+// Which items made it into the catalog depends on how this loader parses
+// them, so a catalog built by any other loader build can't be trusted
+static std::string getCatalogLoaderBuild() {
+    return fmt::format("{}+{}", about::getLoaderVersionStr(), about::getLoaderCommitHash());
+}
+
+/**
+ * The catalog is a flat list of little-endian integers and length-prefixed
+ * strings, so reading it back is a single file read and a linear scan
+ */
+class IndexCatalogWriter final {
+private:
+    ByteVector m_data;
+
+public:
+    void write(uint32_t value) {
+        for (size_t i = 0; i < sizeof(value); i++) {
+            m_data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+    void write(std::string const& value) {
+        this->write(static_cast<uint32_t>(value.size()));
+        m_data.insert(m_data.end(), value.begin(), value.end());
+    }
+    void write(IndexCatalogRecord const& record) {
+        this->write(record.modID);
+        this->write(record.version);
+        this->write(record.modJSON);
+        this->write(record.downloadURL);
+        this->write(record.downloadHash);
+        this->write(static_cast<uint32_t>(record.isFeatured));
+        this->write(static_cast<uint32_t>(record.platforms.size()));
+        for (auto& platform : record.platforms) {
+            this->write(static_cast<uint32_t>(platform.m_value));
+        }
+        this->write(static_cast<uint32_t>(record.tags.size()));
+        for (auto& tag : record.tags) {
+            this->write(tag);
+        }
+    }
+
+    ByteVector const& getData() const {
+        return m_data;
+    }
+};
+
+class IndexCatalogReader final {
+private:
+    ByteVector const& m_data;
+    size_t m_offset = 0;
+
+public:
+    IndexCatalogReader(ByteVector const& data) : m_data(data) {}
+
+    bool read(uint32_t& value) {
+        if (m_data.size() - m_offset < sizeof(value)) return false;
+        value = 0;
+        for (size_t i = 0; i < sizeof(value); i++) {
+            value |= static_cast<uint32_t>(m_data[m_offset++]) << (i * 8);
+        }
+        return true;
+    }
+    bool read(std::string& value) {
+        uint32_t size;
+        if (!this->read(size) || m_data.size() - m_offset < size) return false;
+        auto begin = m_data.begin() + m_offset;
+        value.assign(begin, begin + size);
+        m_offset += size;
+        return true;
+    }
+    bool read(IndexCatalogRecord& record) {
+        uint32_t featured, platformCount, tagCount;
+        if (
+            !this->read(record.modID) ||
+            !this->read(record.version) ||
+            !this->read(record.modJSON) ||
+            !this->read(record.downloadURL) ||
+            !this->read(record.downloadHash) ||
+            !this->read(featured) ||
+            !this->read(platformCount)
+        ) {
+            return false;
+        }
+        record.isFeatured = featured;
+        for (uint32_t i = 0; i < platformCount; i++) {
+            uint32_t platform;
+            if (!this->read(platform)) return false;
+            record.platforms.push_back(PlatformID(static_cast<PlatformID::Type>(platform)));
+        }
+        if (!this->read(tagCount)) return false;
+        for (uint32_t i = 0; i < tagCount; i++) {
+            std::string tag;
+            if (!this->read(tag)) return false;
+            record.tags.push_back(std::move(tag));
+        }
+        return true;
+    }
+};
+
+/**
+ * Run `job` for every index in [0, count) on a pool of worker threads,
+ * blocking until all of them are done
+ */
+static void runIndexWorkers(size_t count, utils::MiniFunction<void(size_t)> job) {
+    std::atomic_size_t next = 0;
+    auto work = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            job(i);
+        }
+    };
+    auto workerCount = std::min<size_t>(
+        count, std::clamp(std::thread::hardware_concurrency(), 1u, 8u)
+    );
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; i++) {
+        workers.emplace_back([&]() {
+            thread::setName("Index Update Worker");
+            work();
+        });
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
 // Index impl
 
 class Index::Impl final {
@@ -246,24 +667,76 @@ public:
     // getting the latest version of a mod as easy as items.rbegin())
     using ItemVersions = std::map<VersionInfo, IndexItemHandle>;
 
+    /**
+     * An immutable view of the whole index. A new snapshot is built off to
+     * the side on every update and then swapped in, so readers only lock to
+     * copy the pointer and never wait for an update
+     */
+    struct Snapshot final {
+        std::unordered_map<std::string, ItemVersions> items;
+        std::vector<IndexItemHandle> allItems;
+        std::vector<IndexItemHandle> latestItems;
+        std::vector<IndexItemHandle> featuredItems;
+        std::unordered_map<std::string, std::vector<IndexItemHandle>> itemsByDeveloper;
+        std::unordered_set<std::string> tags;
+        // the archive the items were read from, if the index isn't extracted
+        std::shared_ptr<IndexArchive> archive;
+
+        void add(std::string const& modID, IndexItemHandle item);
+        void buildIndexes();
+    };
+
+    /**
+     * A running installation of an install list. Every item in the list is
+     * downloaded and verified at the same time (up to a limit), and the
+     * mods are only moved into place once all of them have succeeded
+     */
+    struct Installation final {
+        IndexInstallList list;
+        std::vector<utils::web::SentAsyncWebRequestHandle> requests;
+        std::vector<double> progress;
+        size_t nextToStart = 0;
+        size_t running = 0;
+        size_t finished = 0;
+        bool stopped = false;
+
+        void cancel();
+        uint8_t getProgress() const;
+    };
+
 private:
     std::unordered_map<
         IndexItemHandle,
-        utils::web::SentAsyncWebRequestHandle
+        std::shared_ptr<Installation>
     > m_runningInstallations;
     std::atomic<bool> m_isUpToDate = false;
     std::atomic<bool> m_updating = false;
     std::atomic<bool> m_triedToUpdate = false;
-    std::mutex m_itemsMutex;
-    std::unordered_map<std::string, ItemVersions> m_items;
+    // whether the index is kept as the downloaded archive instead of
+    // being extracted
+    std::atomic<bool> m_useArchive = false;
+    // only held to copy or swap the pointer
+    mutable std::mutex m_snapshotMutex;
+    std::shared_ptr<Snapshot const> m_snapshot = std::make_shared<Snapshot>();
 
     friend class Index;
 
-    void cleanupItems();
+    std::shared_ptr<Snapshot const> getSnapshot() const;
+    void publish(std::shared_ptr<Snapshot const> snapshot);
+
+    using CatalogItems = std::vector<std::pair<std::string, IndexItemHandle>>;
+    Result<CatalogItems> loadCatalog(std::string const& commitHash, std::shared_ptr<IndexArchive> archive);
+    void saveCatalog(std::string const& commitHash, CatalogItems const& items);
+    Result<CatalogItems> parseLocalTree(std::shared_ptr<IndexArchive> archive);
     void downloadIndex(std::string commitHash = "");
+    void finishDownload(std::string const& commitHash);
+    bool hasLocalIndex() const;
     void checkForUpdates();
     void updateFromLocalTree();
-    void installNext(size_t index, IndexInstallList const& list);
+    void startDownloads(std::shared_ptr<Installation> install);
+    void startDownload(std::shared_ptr<Installation> install, size_t index);
+    void finishInstall(std::shared_ptr<Installation> install);
+    void failInstall(std::shared_ptr<Installation> install, std::string const& error);
 
 public:
     Impl() {
@@ -285,18 +758,43 @@ Index* Index::get() {
 
 // Updating
 
-void Index::Impl::cleanupItems() {
-    std::scoped_lock lock(m_itemsMutex);
-    // delete mods with no versions
-    for (auto it = m_items.begin(); it != m_items.end(); ) {
-        if (!it->second.size()) {
-            it = m_items.erase(it);
-        } else {
-            ++it;
+void Index::Impl::Snapshot::add(std::string const& modID, IndexItemHandle item) {
+    items[modID].insert({ item->m_impl->getBaseMetadata().getVersion(), item });
+}
+
+void Index::Impl::Snapshot::buildIndexes() {
+    for (auto& [modID, versions] : items) {
+        if (versions.empty()) continue;
+        latestItems.push_back(versions.rbegin()->second);
+        for (auto& [_, item] : versions) {
+            allItems.push_back(item);
+            if (item->isFeatured()) {
+                featuredItems.push_back(item);
+            }
+            for (auto& dev : item->m_impl->getBaseMetadata().getDevelopers()) {
+                itemsByDeveloper[dev].push_back(item);
+            }
+            for (auto& tag : item->getTags()) {
+                tags.insert(tag);
+            }
         }
     }
 }
 
+std::shared_ptr<Index::Impl::Snapshot const> Index::Impl::getSnapshot() const {
+    std::lock_guard lock(m_snapshotMutex);
+    return m_snapshot;
+}
+
+void Index::Impl::publish(std::shared_ptr<Snapshot const> snapshot) {
+    {
+        std::lock_guard lock(m_snapshotMutex);
+        std::swap(m_snapshot, snapshot);
+    }
+    // the old snapshot is freed here (if no one else holds it), outside
+    // the lock
+}
+
 bool Index::isUpToDate() const {
     return m_impl->m_isUpToDate;
 }
@@ -309,6 +807,23 @@ bool Index::hasTriedToUpdate() const {
     return m_impl->m_triedToUpdate;
 }
 
+void Index::Impl::finishDownload(std::string const& commitHash) {
+    if (!commitHash.empty()) {
+        auto const checksumPath = dirs::getIndexDir() / ".checksum";
+        (void)file::writeString(checksumPath, commitHash);
+    }
+    this->updateFromLocalTree();
+}
+
+bool Index::Impl::hasLocalIndex() const {
+    std::error_code ec;
+    if (m_useArchive) {
+        auto archivePath = getIndexArchivePath();
+        return archivePath && ghc::filesystem::exists(*archivePath, ec);
+    }
+    return ghc::filesystem::exists(getIndexTreeDir() / "config.json", ec);
+}
+
 void Index::Impl::downloadIndex(std::string commitHash) {
     log::debug("Downloading index");
 
@@ -324,9 +839,40 @@ void Index::Impl::downloadIndex(std::string commitHash) {
             std::thread([=, this]() {
                 thread::setName("Index Update");
 
-                auto targetDir = dirs::getIndexDir() / "v0";
-                // delete old unzipped index
+                auto targetDir = getIndexTreeDir();
                 std::error_code ec;
+                ghc::filesystem::remove(getIndexCatalogPath(), ec);
+
+                if (m_useArchive) {
+                    // keep the archive as-is; the tree is read straight
+                    // from it. the current archive may still be open, so
+                    // the new one gets a name of its own
+                    auto name = fmt::format(
+                        "index-{}.zip", std::chrono::system_clock::now().time_since_epoch().count()
+                    );
+                    (void)file::createDirectoryAll(getIndexArchivesDir());
+                    ghc::filesystem::rename(targetFile, getIndexArchivesDir() / name, ec);
+                    auto saveRes = ec ?
+                        Result<>(Err(ec.message())) :
+                        file::writeString(getIndexArchiveNamePath(), name);
+                    if (!saveRes) {
+                        auto const err = fmt::format("Unable to save index: {}", saveRes.unwrapErr());
+                        log::error("{}", err);
+                        Loader::get()->queueInMainThread([err] {
+                            IndexUpdateEvent(UpdateFailed(err)).post();
+                        });
+                        return;
+                    }
+                    // an index extracted earlier would be out of date now
+                    ghc::filesystem::remove_all(targetDir, ec);
+                    this->finishDownload(commitHash);
+                    return;
+                }
+                // the archives themselves are deleted once the extracted
+                // index is loaded
+                ghc::filesystem::remove(getIndexArchiveNamePath(), ec);
+
+                // delete old unzipped index
                 if (ghc::filesystem::exists(targetDir, ec)) {
                     ghc::filesystem::remove_all(targetDir, ec);
                     if (ec) {
@@ -362,12 +908,7 @@ void Index::Impl::downloadIndex(std::string commitHash) {
 
                 // remove the directory github adds to the root of the zip
                 (void)flattenGithubRepo(targetDir);
-                if (!commitHash.empty()) {
-                    auto const checksumPath = dirs::getIndexDir() / ".checksum";
-                    (void)file::writeString(checksumPath, commitHash);
-                }
-
-                this->updateFromLocalTree();
+                this->finishDownload(commitHash);
             }).detach();
         })
         .expect([](std::string const& err) {
@@ -388,7 +929,7 @@ void Index::Impl::downloadIndex(std::string commitHash) {
 }
 
 void Index::Impl::checkForUpdates() {
-    if (m_isUpToDate) {
+    if (m_isUpToDate && this->hasLocalIndex()) {
         std::thread([this](){
             thread::setName("Index Update");
             this->updateFromLocalTree();
@@ -419,7 +960,7 @@ void Index::Impl::checkForUpdates() {
                 // same as old
                 (newSHA.empty() || oldSHA == newSHA) &&
                 // make sure the downloaded local copy actually exists
-                ghc::filesystem::exists(dirs::getIndexDir() / "v0" / "config.json")
+                this->hasLocalIndex()
             ) {
                 std::thread([this](){
                     thread::setName("Index Update");
@@ -440,28 +981,99 @@ void Index::Impl::checkForUpdates() {
 }
 
 // TODO: gross hack :3 (ctrl+f this comment to find the other part)
-extern bool s_jsonCheckerShouldCheckUnknownKeys;
-void Index::Impl::updateFromLocalTree() {
-    log::debug("Updating local index cache");
-    log::pushNest();
-    std::unique_lock<std::mutex> lock(m_itemsMutex);
+extern thread_local bool s_jsonCheckerShouldCheckUnknownKeys;
 
-    Loader::get()->queueInMainThread([](){
-        IndexUpdateEvent(UpdateProgress(100, "Updating local cache")).post();
+Result<Index::Impl::CatalogItems> Index::Impl::loadCatalog(
+    std::string const& commitHash, std::shared_ptr<IndexArchive> archive
+) {
+    if (commitHash.empty()) {
+        return Err("Index commit is unknown");
+    }
+    GEODE_UNWRAP_INTO(auto data, file::readBinary(getIndexCatalogPath()));
+    IndexCatalogReader reader(data);
+
+    uint32_t magic, version, count;
+    std::string loaderBuild, hash;
+    if (!reader.read(magic) || magic != INDEX_CATALOG_MAGIC) {
+        return Err("Not an index catalog");
+    }
+    if (!reader.read(version) || version != INDEX_CATALOG_VERSION) {
+        return Err("Outdated catalog version");
+    }
+    if (!reader.read(loaderBuild) || loaderBuild != getCatalogLoaderBuild()) {
+        return Err("Catalog was built by a different loader");
+    }
+    if (!reader.read(hash) || hash != commitHash) {
+        return Err("Catalog is for a different index commit");
+    }
+    if (!reader.read(count)) {
+        return Err("Catalog is truncated");
+    }
+    std::vector<IndexCatalogRecord> records(count);
+    for (auto& record : records) {
+        if (!reader.read(record)) {
+            return Err("Catalog is truncated");
+        }
+    }
+
+    auto entriesRoot = getIndexTreeDir() / "mods-v2";
+    std::vector<IndexItemHandle> parsed(records.size());
+    std::atomic_bool failed = false;
+    runIndexWorkers(records.size(), [&](size_t i) {
+        // anything worth warning about was already logged when the
+        // catalog was built
+        s_jsonCheckerShouldCheckUnknownKeys = false;
+        auto res = IndexItem::Impl::create(archive, entriesRoot, records[i]);
+        s_jsonCheckerShouldCheckUnknownKeys = true;
+        if (!res) {
+            failed = true;
+            return;
+        }
+        parsed[i] = res.unwrap();
     });
-    // delete old items
-    m_items.clear();
-    lock.unlock();
+    if (failed) {
+        return Err("Catalog contains invalid items");
+    }
 
-    auto indexRoot = dirs::getIndexDir() / "v0";
-    auto entriesRoot = indexRoot / "mods-v2";
+    CatalogItems items;
+    items.reserve(records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        items.emplace_back(std::move(records[i].modID), std::move(parsed[i]));
+    }
+    return Ok(items);
+}
 
-    auto configRes = file::readJson(indexRoot / "config.json");
-    if (!configRes) {
-        IndexUpdateEvent("Unable to read index config").post();
-        return;
+void Index::Impl::saveCatalog(std::string const& commitHash, CatalogItems const& items) {
+    IndexCatalogWriter writer;
+    writer.write(INDEX_CATALOG_MAGIC);
+    writer.write(INDEX_CATALOG_VERSION);
+    writer.write(getCatalogLoaderBuild());
+    writer.write(commitHash);
+    writer.write(static_cast<uint32_t>(items.size()));
+    for (auto& [modID, item] : items) {
+        writer.write(item->m_impl->toRecord(modID));
+    }
+    auto res = file::writeBinary(getIndexCatalogPath(), writer.getData());
+    if (!res) {
+        log::warn("Unable to save index catalog: {}", res.unwrapErr());
     }
-    auto config = configRes.unwrap();
+}
+
+Result<Index::Impl::CatalogItems> Index::Impl::parseLocalTree(std::shared_ptr<IndexArchive> archive) {
+    auto indexRoot = getIndexTreeDir();
+    auto entriesRoot = indexRoot / "mods-v2";
+
+    GEODE_UNWRAP_INTO(
+        auto config, readIndexJson(archive.get(), indexRoot / "config.json")
+            .expect("Unable to read index config")
+    );
+
+    struct Job {
+        std::string modID;
+        std::string version;
+        bool isLatest;
+    };
+    std::vector<Job> jobs;
 
     JsonChecker checker(config);
     auto root = checker.root("[index/config.json]").obj();
@@ -469,27 +1081,109 @@ void Index::Impl::updateFromLocalTree() {
     for (auto& [modID, entry] : root.has("entries").items()) {
         auto versions = entry.obj().has("versions");
         for (auto& version : entry.obj().has("versions").iterate()) {
-            s_jsonCheckerShouldCheckUnknownKeys =
-                version.get<std::string>() == (versions.iterate().end() - 1)->get<std::string>();
+            jobs.push_back({
+                modID, version.get<std::string>(),
+                version.get<std::string>() == (versions.iterate().end() - 1)->get<std::string>()
+            });
+        }
+    }
+
+    std::vector<IndexItemHandle> parsed(jobs.size());
+    runIndexWorkers(jobs.size(), [&](size_t i) {
+        auto& job = jobs[i];
+        // only warn about unknown keys for the latest version of each mod
+        s_jsonCheckerShouldCheckUnknownKeys = job.isLatest;
+
+        auto rootDir = entriesRoot / job.modID;
+        auto dir = rootDir / job.version;
+
+        auto addRes = IndexItem::Impl::create(archive, rootDir, dir);
+        s_jsonCheckerShouldCheckUnknownKeys = true;
+        if (!addRes) {
+            // log::warn("Unable to add index item from {}: {}", dir, addRes.unwrapErr());
+            return;
+        }
+        parsed[i] = addRes.unwrap();
+    });
+
+    CatalogItems items;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (parsed[i]) {
+            items.emplace_back(std::move(jobs[i].modID), std::move(parsed[i]));
+        }
+    }
+    return Ok(items);
+}
+
+void Index::Impl::updateFromLocalTree() {
+    log::debug("Updating local index cache");
+    log::pushNest();
 
-            auto rootDir = entriesRoot / modID;
-            auto dir = rootDir / version.get<std::string>();
+    Loader::get()->queueInMainThread([](){
+        IndexUpdateEvent(UpdateProgress(100, "Updating local cache")).post();
+    });
 
-            auto addRes = IndexItem::Impl::create(rootDir, dir);
-            if (!addRes) {
-                // log::warn("Unable to add index item from {}: {}", dir, addRes.unwrapErr());
-                continue;
+    // the archive of the current snapshot is reused if it's still the
+    // latest one
+    std::shared_ptr<IndexArchive> archive;
+    if (m_useArchive) {
+        auto archivePath = getIndexArchivePath();
+        auto current = this->getSnapshot()->archive;
+        if (current && archivePath && current->getPath() == *archivePath) {
+            archive = current;
+        }
+        else {
+            auto openRes = archivePath ?
+                IndexArchive::open(*archivePath) :
+                Result<std::shared_ptr<IndexArchive>>(Err("No archive has been downloaded"));
+            if (!openRes) {
+                auto const err = "Unable to open index archive: " + openRes.unwrapErr();
+                log::error("{}", err);
+                Loader::get()->queueInMainThread([err]() {
+                    IndexUpdateEvent(UpdateFailed(err)).post();
+                });
+                log::popNest();
+                return;
             }
-            auto add = addRes.unwrap();
-            auto metadata = add->getMetadata();
+            archive = openRes.unwrap();
+        }
+    }
 
-            lock.lock();
-            m_items[modID].insert({metadata.getVersion(),
-                add
+    // the tree only changes when a new index is downloaded, so if the
+    // catalog was built for the current commit it can be used as-is
+    auto commitHash = file::readString(dirs::getIndexDir() / ".checksum").unwrapOr("");
+    CatalogItems items;
+    auto catalogRes = this->loadCatalog(commitHash, archive);
+    if (catalogRes) {
+        items = std::move(catalogRes.unwrap());
+    }
+    else {
+        log::debug("Parsing index tree: {}", catalogRes.unwrapErr());
+        auto parseRes = this->parseLocalTree(archive);
+        if (!parseRes) {
+            auto const err = parseRes.unwrapErr();
+            log::error("Failed to parse index: {}", err);
+            Loader::get()->queueInMainThread([err]() {
+                IndexUpdateEvent(UpdateFailed(err)).post();
             });
-            lock.unlock();
+            log::popNest();
+            return;
         }
+        items = std::move(parseRes.unwrap());
+        if (!commitHash.empty()) {
+            this->saveCatalog(commitHash, items);
+        }
+    }
+
+    // the previous snapshot stays readable until this one is done
+    auto snapshot = std::make_shared<Snapshot>();
+    for (auto& [modID, item] : items) {
+        snapshot->add(modID, item);
     }
+    snapshot->buildIndexes();
+    snapshot->archive = archive;
+    this->publish(std::move(snapshot));
+    removeOldIndexArchives(archive ? archive->getPath().filename() : ghc::filesystem::path());
 
     // mark source as finished
     m_isUpToDate = true;
@@ -507,6 +1201,7 @@ void Index::update(bool force) {
     (void) file::createDirectoryAll(dirs::getIndexDir());
 
     m_impl->m_triedToUpdate = true;
+    m_impl->m_useArchive = Mod::get()->getSettingValue<bool>("read-index-from-archive");
 
     // check if update is already happening
     if (m_impl->m_updating) {
@@ -526,62 +1221,36 @@ void Index::update(bool force) {
 // Items
 
 std::vector<IndexItemHandle> Index::getItems() const {
-    std::scoped_lock lock(m_impl->m_itemsMutex);
-    std::vector<IndexItemHandle> res;
-    for (auto& items : map::values(m_impl->m_items)) {
-        for (auto& item : items) {
-            res.push_back(item.second);
-        }
-    }
-    return res;
+    return m_impl->getSnapshot()->allItems;
 }
 
 std::vector<IndexItemHandle> Index::getLatestItems() const {
-    std::unique_lock<std::mutex> lock(m_impl->m_itemsMutex);
-    std::vector<IndexItemHandle> res;
-    for (auto& [modID, versions] : m_impl->m_items) {
-        lock.unlock();
-        res.push_back(this->getMajorItem(modID));
-        lock.lock();
-    }
-    return res;
+    return m_impl->getSnapshot()->latestItems;
 }
 
 std::vector<IndexItemHandle> Index::getFeaturedItems() const {
-    std::scoped_lock lock(m_impl->m_itemsMutex);
-    std::vector<IndexItemHandle> res;
-    for (auto& items : map::values(m_impl->m_items)) {
-        for (auto& item : items) {
-            if (item.second->isFeatured()) {
-                res.push_back(item.second);
-            }
-        }
-    }
-    return res;
+    return m_impl->getSnapshot()->featuredItems;
 }
 
 std::vector<IndexItemHandle> Index::getItemsByDeveloper(
     std::string const& name
 ) const {
-    std::scoped_lock lock(m_impl->m_itemsMutex);
-    std::vector<IndexItemHandle> res;
-    for (auto& items : map::values(m_impl->m_items)) {
-        for (auto& item : items) {
-            if (ranges::contains(item.second->getMetadata().getDevelopers(), name)) {
-                res.push_back(item.second);
-            }
-        }
+    auto snapshot = m_impl->getSnapshot();
+    auto it = snapshot->itemsByDeveloper.find(name);
+    if (it == snapshot->itemsByDeveloper.end()) {
+        return {};
     }
-    return res;
+    return it->second;
 }
 
 std::vector<IndexItemHandle> Index::getItemsByModID(
     std::string const& modID
 ) const {
-    std::scoped_lock lock(m_impl->m_itemsMutex);
+    auto snapshot = m_impl->getSnapshot();
     std::vector<IndexItemHandle> res;
-    if (m_impl->m_items.count(modID)) {
-        for (auto& [versionStr, item] : m_impl->m_items[modID]) {
+    auto it = snapshot->items.find(modID);
+    if (it != snapshot->items.end()) {
+        for (auto& [_, item] : it->second) {
             res.push_back(item);
         }
     }
@@ -598,9 +1267,10 @@ bool Index::isKnownItem(
 IndexItemHandle Index::getMajorItem(
     std::string const& id
 ) const {
-    std::scoped_lock lock(m_impl->m_itemsMutex);
-    if (m_impl->m_items.count(id)) {
-        return m_impl->m_items.at(id).rbegin()->second;
+    auto snapshot = m_impl->getSnapshot();
+    auto it = snapshot->items.find(id);
+    if (it != snapshot->items.end() && !it->second.empty()) {
+        return it->second.rbegin()->second;
     }
     return nullptr;
 }
@@ -609,30 +1279,30 @@ IndexItemHandle Index::getItem(
     std::string const& id,
     std::optional<VersionInfo> version
 ) const {
-    std::unique_lock<std::mutex> lock(m_impl->m_itemsMutex);
-    if (m_impl->m_items.count(id)) {
-        auto versions = m_impl->m_items.at(id);
-        if (version) {
-            for (auto& [_, item] : ranges::reverse(m_impl->m_items.at(id))) {
-                if (version.value() == item->getMetadata().getVersion()) {
-                    return item;
-                }
-            }
+    auto snapshot = m_impl->getSnapshot();
+    auto it = snapshot->items.find(id);
+    if (it == snapshot->items.end() || it->second.empty()) {
+        return nullptr;
+    }
+    if (version) {
+        auto item = it->second.find(version.value());
+        if (item != it->second.end()) {
+            return item->second;
         }
     }
-    lock.unlock();
-    return this->getMajorItem(id);
+    return it->second.rbegin()->second;
 }
 
 IndexItemHandle Index::getItem(
     std::string const& id,
     ComparableVersionInfo version
 ) const {
-    std::scoped_lock lock(m_impl->m_itemsMutex);
-    if (m_impl->m_items.count(id)) {
+    auto snapshot = m_impl->getSnapshot();
+    auto it = snapshot->items.find(id);
+    if (it != snapshot->items.end()) {
         // prefer most major version
-        for (auto& [_, item] : ranges::reverse(m_impl->m_items.at(id))) {
-            if (version.compare(item->getMetadata().getVersion())) {
+        for (auto& [_, item] : ranges::reverse(it->second)) {
+            if (version.compare(item->m_impl->getBaseMetadata().getVersion())) {
                 return item;
             }
         }
@@ -657,7 +1327,7 @@ bool Index::isUpdateAvailable(IndexItemHandle item) const {
 }
 
 bool Index::areUpdatesAvailable() const {
-    for (auto& mod : Loader::get()->getAllMods()) {
+    for (auto& mod : Loader::get()->getAllModsView()) {
         auto item = this->getMajorItem(mod->getID());
         if (item && item->getMetadata().getVersion() > mod->getVersion() && mod->isEnabled()) {
             return true;
@@ -761,85 +1431,169 @@ Result<IndexInstallList> Index::getInstallList(IndexItemHandle item) const {
     return Ok(list);
 }
 
-void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
-    auto postError = [this, list](std::string const& error) {
-        m_runningInstallations.erase(list.target);
-        ModInstallEvent(list.target->getMetadata().getID(), error).post();
-    };
+void Index::Impl::Installation::cancel() {
+    stopped = true;
+    for (auto& request : requests) {
+        if (request) request->cancel();
+    }
+}
 
-    // If we're at the end of the list, move the downloaded items to mods
-    if (index >= list.list.size()) {
-        m_runningInstallations.erase(list.target);
-        // Move all downloaded files
-        for (auto& item : list.list) {
-            // If the mod is already installed, delete the old .geode file
-            if (auto mod = Loader::get()->getInstalledMod(item->getMetadata().getID())) {
-                auto res = mod->uninstall();
-                if (!res) {
-                    return postError(fmt::format(
-                        "Unable to uninstall old version of {}: {}",
-                        item->getMetadata().getID(), res.unwrapErr()
-                    ));
-                }
-            }
+uint8_t Index::Impl::Installation::getProgress() const {
+    double total = 0.0;
+    for (auto& p : progress) {
+        total += p;
+    }
+    return static_cast<uint8_t>(total / progress.size() * 100.0);
+}
 
-            // Move the temp file
-            std::error_code ec;
-            ghc::filesystem::rename(
-                dirs::getTempDir() / (item->getMetadata().getID() + ".index"),
-                dirs::getModsDir() / (item->getMetadata().getID() + ".geode"), ec
-            );
-            if (ec) {
-                return postError(fmt::format(
-                    "Unable to move downloaded file for {}: {}",
-                    item->getMetadata().getID(), ec.message()
+void Index::Impl::failInstall(std::shared_ptr<Installation> install, std::string const& error) {
+    // the other downloads report their cancellation too, but the first
+    // error is the one that matters
+    if (install->stopped) return;
+    install->cancel();
+    m_runningInstallations.erase(install->list.target);
+    ModInstallEvent(install->list.target->getMetadata().getID(), error).post();
+}
+
+// Partial downloads are resumed, so they're kept apart per version and
+// expected file; resuming one URL's file against another would only end in
+// a checksum mismatch
+static ghc::filesystem::path getPartialDownloadPath(IndexItemHandle item) {
+    return dirs::getTempDir() / fmt::format(
+        "{}@{}-{}.index",
+        item->getMetadata().getID(),
+        item->getMetadata().getVersion().toString(),
+        item->getPackageHash().substr(0, 16)
+    );
+}
+
+static void removeStalePartialDownloads(IndexItemHandle item) {
+    auto const& id = item->getMetadata().getID();
+    auto current = getPartialDownloadPath(item).filename().string();
+    std::error_code ec;
+    for (auto& entry : ghc::filesystem::directory_iterator(dirs::getTempDir(), ec)) {
+        auto name = entry.path().filename().string();
+        bool partial = name == id + ".index" || (
+            name.starts_with(id + "@") && name.ends_with(".index")
+        );
+        if (partial && name != current) {
+            std::error_code removeEc;
+            ghc::filesystem::remove(entry.path(), removeEc);
+        }
+    }
+}
+
+void Index::Impl::finishInstall(std::shared_ptr<Installation> install) {
+    m_runningInstallations.erase(install->list.target);
+    // Move all downloaded files
+    for (auto& item : install->list.list) {
+        // If the mod is already installed, delete the old .geode file
+        if (auto mod = Loader::get()->getInstalledMod(item->getMetadata().getID())) {
+            auto res = mod->uninstall();
+            if (!res) {
+                return this->failInstall(install, fmt::format(
+                    "Unable to uninstall old version of {}: {}",
+                    item->getMetadata().getID(), res.unwrapErr()
                 ));
             }
         }
 
-        auto const& eventModID = list.target->getMetadata().getID();
-        Loader::get()->queueInMainThread([eventModID]() {
-            ModInstallEvent(eventModID, UpdateFinished()).post();
-        });
+        // Move the temp file
+        std::error_code ec;
+        ghc::filesystem::rename(
+            getPartialDownloadPath(item),
+            dirs::getModsDir() / (item->getMetadata().getID() + ".geode"), ec
+        );
+        if (ec) {
+            return this->failInstall(install, fmt::format(
+                "Unable to move downloaded file for {}: {}",
+                item->getMetadata().getID(), ec.message()
+            ));
+        }
+    }
+    install->stopped = true;
 
-        return;
+    auto const& eventModID = install->list.target->getMetadata().getID();
+    Loader::get()->queueInMainThread([eventModID]() {
+        ModInstallEvent(eventModID, UpdateFinished()).post();
+    });
+}
+
+void Index::Impl::startDownloads(std::shared_ptr<Installation> install) {
+    if (install->stopped) return;
+
+    // If every item has been downloaded, move them to mods
+    if (install->finished >= install->list.list.size()) {
+        return this->finishInstall(install);
     }
 
-    auto scaledProgress = [index, list](double progress) -> uint8_t {
-        return static_cast<uint8_t>(
-            progress * (static_cast<double>(index + 1) / list.list.size())
-        );
+    auto limit = static_cast<size_t>(std::max<int64_t>(
+        Mod::get()->getSettingValue<int64_t>("max-concurrent-downloads"), 1
+    ));
+    while (install->running < limit && install->nextToStart < install->list.list.size()) {
+        this->startDownload(install, install->nextToStart++);
+    }
+}
+
+void Index::Impl::startDownload(std::shared_ptr<Installation> install, size_t index) {
+    auto postProgress = [install](std::string const& status) {
+        ModInstallEvent(
+            install->list.target->getMetadata().getID(),
+            UpdateProgress(install->getProgress(), status)
+        ).post();
+    };
+    auto downloadStatus = [install]() {
+        if (install->list.list.size() == 1) {
+            return fmt::format("Downloading {}", install->list.target->getMetadata().getID());
+        }
+        return fmt::format("Downloading ({}/{})", install->finished, install->list.list.size());
+    };
+
+    struct StreamedHash {
+        HashCalculator calculator;
+        uint64_t size = 0;
     };
 
-    auto item = list.list.at(index);
-    auto tempFile = dirs::getTempDir() / (item->getMetadata().getID() + ".index");
+    auto item = install->list.list.at(index);
+    auto tempFile = getPartialDownloadPath(item);
+    removeStalePartialDownloads(item);
+    // the file is hashed while it's being downloaded, so it doesn't have to
+    // be read again afterwards
+    auto hash = std::make_shared<StreamedHash>();
     log::debug("Installing {}", item->getMetadata().getID());
-    m_runningInstallations[list.target] = web::AsyncWebRequest()
+    install->running += 1;
+    install->requests[index] = web::AsyncWebRequest()
         .join("install_item_" + item->getMetadata().getID())
+        .resumable()
+        .received([hash](uint64_t offset, uint8_t const* data, size_t size) {
+            if (offset == 0) {
+                hash->calculator.reset();
+                hash->size = 0;
+            }
+            hash->calculator.add(data, size);
+            hash->size += size;
+        })
         .fetch(item->getDownloadURL())
         .into(tempFile)
         .then([=, this](auto) {
-            // Check for 404
-            auto notFound = utils::file::readString(tempFile);
-            if (notFound && notFound.unwrap() == "Not Found") {
-                return postError(fmt::format(
-                    "Binary file download for {} returned \"404 Not found\". "
-                    "Report this to the Geode development team.",
-                    item->getMetadata().getID()
-                ));
-            }
+            if (install->stopped) return;
 
             // Verify checksum
-            ModInstallEvent(
-                list.target->getMetadata().getID(),
-                UpdateProgress(
-                    scaledProgress(100),
-                    fmt::format("Verifying {}", item->getMetadata().getID())
-                )
-            ).post();
+            install->progress[index] = 1.0;
+            postProgress(fmt::format("Verifying {}", item->getMetadata().getID()));
 
-            if (::calculateHash(tempFile) != item->getPackageHash()) {
-                return postError(fmt::format(
+            // if this request joined another one for the same item, it
+            // didn't see the data and the file has to be hashed after all
+            std::error_code ec;
+            auto fileSize = ghc::filesystem::file_size(tempFile, ec);
+            auto checksum = !ec && fileSize == hash->size ?
+                hash->calculator.getHash() :
+                ::calculateHash(tempFile);
+
+            if (checksum != item->getPackageHash()) {
+                // don't try to resume from a broken file next time
+                ghc::filesystem::remove(tempFile, ec);
+                return this->failInstall(install, fmt::format(
                     "Checksum mismatch with {}! (Downloaded file did not match what "
                     "was expected. Try again, and if the download fails another time, "
                     "report this to the Geode development team.)",
@@ -851,26 +1605,30 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
 
             log::debug("Installed {}", item->getMetadata().getID());
 
-            // Install next item in queue
-            this->installNext(index + 1, list);
+            install->running -= 1;
+            install->finished += 1;
+            this->startDownloads(install);
         })
-        .expect([postError, list, item](std::string const& err) {
-            postError(fmt::format(
+        .expect([=, this](std::string const& err, int code) {
+            if (code == 404) {
+                return this->failInstall(install, fmt::format(
+                    "Binary file download for {} returned \"404 Not found\". "
+                    "Report this to the Geode development team.",
+                    item->getMetadata().getID()
+                ));
+            }
+            this->failInstall(install, fmt::format(
                 "Unable to download {}: {}",
                 item->getMetadata().getID(), err
             ));
         })
-        .progress([this, item, list, scaledProgress](auto&, double now, double total) {
-            ModInstallEvent(
-                list.target->getMetadata().getID(),
-                UpdateProgress(
-                    scaledProgress(now / total * 100.0),
-                    fmt::format("Downloading {}", item->getMetadata().getID())
-                )
-            ).post();
+        .progress([=](auto&, double now, double total) {
+            if (install->stopped || total <= 0.0) return;
+            install->progress[index] = now / total;
+            postProgress(downloadStatus());
         })
-        .cancelled([postError](auto&) {
-            postError("Download cancelled");
+        .cancelled([=, this](auto&) {
+            this->failInstall(install, "Download cancelled");
         })
         .send();
 }
@@ -878,8 +1636,12 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
 void Index::cancelInstall(IndexItemHandle item) {
     Loader::get()->queueInMainThread([this, item]() {
         if (m_impl->m_runningInstallations.count(item)) {
-            m_impl->m_runningInstallations.at(item)->cancel();
+            auto install = m_impl->m_runningInstallations.at(item);
             m_impl->m_runningInstallations.erase(item);
+            // the requests' cancelled callbacks see the install as stopped
+            // and stay quiet, so the cancel has to be reported here
+            install->cancel();
+            ModInstallEvent(item->getMetadata().getID(), "Download cancelled").post();
         }
     });
 }
@@ -890,7 +1652,12 @@ void Index::install(IndexInstallList const& list) {
         return;
     }
     Loader::get()->queueInMainThread([this, list]() {
-        m_impl->installNext(0, list);
+        auto install = std::make_shared<Impl::Installation>();
+        install->list = list;
+        install->requests.resize(list.list.size());
+        install->progress.resize(list.list.size(), 0.0);
+        m_impl->m_runningInstallations[list.target] = install;
+        m_impl->startDownloads(install);
     });
 }
 
@@ -914,14 +1681,5 @@ void Index::install(IndexItemHandle item) {
 // Item properites
 
 std::unordered_set<std::string> Index::getTags() const {
-    std::scoped_lock lock(m_impl->m_itemsMutex);
-    std::unordered_set<std::string> tags;
-    for (auto& [_, versions] : m_impl->m_items) {
-        for (auto& [_, item] : versions) {
-            for (auto& tag : item->getTags()) {
-                tags.insert(tag);
-            }
-        }
-    }
-    return tags;
+    return m_impl->getSnapshot()->tags;
 }
@@ -65,6 +65,10 @@ std::vector<Mod*> Loader::getAllMods() {
     return m_impl->getAllMods();
 }
 
+std::span<Mod* const> Loader::getAllModsView() const {
+    return m_impl->m_modList;
+}
+
 std::vector<LoadProblem> Loader::getProblems() const {
     return m_impl->getProblems();
 }
@@ -18,6 +18,9 @@
 #include <Geode/utils/string.hpp>
 #include <Geode/utils/web.hpp>
 #include <about.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <crashlog.hpp>
 #include <fmt/format.h>
 #include <hash.hpp>
@@ -27,6 +30,7 @@
 #include <resources.hpp>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 using namespace geode::prelude;
@@ -64,6 +68,14 @@ void Loader::Impl::createDirectories() {
     if (!ranges::contains(m_modSearchDirectories, dirs::getModsDir())) {
         m_modSearchDirectories.push_back(dirs::getModsDir());
     }
+
+    // lets a generated set of mods be loaded next to the installed ones
+    if (auto extra = this->getLaunchArgument("extra-mods-dir")) {
+        ghc::filesystem::path dir = *extra;
+        if (ghc::filesystem::is_directory(dir) && !ranges::contains(m_modSearchDirectories, dir)) {
+            m_modSearchDirectories.push_back(dir);
+        }
+    }
 }
 
 Result<> Loader::Impl::setup() {
@@ -128,7 +140,7 @@ void Loader::Impl::updateResources(bool forceReload) {
 }
 
 std::vector<Mod*> Loader::Impl::getAllMods() {
-    return map::values(m_mods);
+    return m_modList;
 }
 
 // Version info
@@ -185,78 +197,239 @@ void Loader::Impl::loadData() {
 
 // Mod loading
 
-bool Loader::Impl::isModInstalled(std::string const& id) const {
-    return m_mods.count(id) && !m_mods.at(id)->isUninstalled();
+Mod* Loader::Impl::findMod(std::string_view id) const {
+    auto it = m_mods.find(id);
+    return it != m_mods.end() ? it->second : nullptr;
+}
+
+bool Loader::Impl::isModInstalled(std::string_view id) const {
+    return this->getInstalledMod(id);
 }
 
-Mod* Loader::Impl::getInstalledMod(std::string const& id) const {
-    if (m_mods.count(id) && !m_mods.at(id)->isUninstalled()) {
-        return m_mods.at(id);
+Mod* Loader::Impl::getInstalledMod(std::string_view id) const {
+    auto mod = this->findMod(id);
+    if (mod && !mod->isUninstalled()) {
+        return mod;
     }
     return nullptr;
 }
 
-bool Loader::Impl::isModLoaded(std::string const& id) const {
-    return m_mods.count(id) && m_mods.at(id)->isEnabled();
+bool Loader::Impl::isModLoaded(std::string_view id) const {
+    return this->getLoadedMod(id);
 }
 
-Mod* Loader::Impl::getLoadedMod(std::string const& id) const {
-    if (m_mods.count(id)) {
-        auto mod = m_mods.at(id);
-        if (mod->isEnabled()) {
-            return mod;
-        }
+Mod* Loader::Impl::getLoadedMod(std::string_view id) const {
+    auto mod = this->findMod(id);
+    if (mod && mod->isEnabled()) {
+        return mod;
     }
     return nullptr;
 }
 
-void Loader::Impl::updateModResources(Mod* mod) {
+std::vector<Loader::Impl::SpritesheetToLoad> Loader::Impl::resolveModSpritesheets(Mod* mod) {
     if (mod != Mod::get()) {
         // geode.loader resource is stored somewhere else, which is already added anyway
         auto searchPathRoot = dirs::getModRuntimeDir() / mod->getID() / "resources";
         CCFileUtils::get()->addSearchPath(searchPathRoot.string().c_str());
     }
 
-    // only thing needs previous setup is spritesheets
-    if (mod->getMetadata().getSpritesheets().empty())
-        return;
-
-    log::debug("{}", mod->getID());
-    log::pushNest();
-
+    std::vector<SpritesheetToLoad> sheets;
+    // CCFileUtils isn't thread safe, so the paths are resolved here once
+    // and the full paths are used from then on
+    auto ccfu = CCFileUtils::get();
     for (auto const& sheet : mod->getMetadata().getSpritesheets()) {
-        log::debug("Adding sheet {}", sheet);
         auto png = sheet + ".png";
         auto plist = sheet + ".plist";
-        auto ccfu = CCFileUtils::get();
+        std::string pngPath = ccfu->fullPathForFilename(png.c_str(), false);
+        std::string plistPath = ccfu->fullPathForFilename(plist.c_str(), false);
 
-        if (png == std::string(ccfu->fullPathForFilename(png.c_str(), false)) ||
-            plist == std::string(ccfu->fullPathForFilename(plist.c_str(), false))) {
+        if (png == pngPath || plist == plistPath) {
             log::warn(
                 R"(The resource dir of "{}" is missing "{}" png and/or plist files)",
                 mod->getID(), sheet
             );
+            continue;
         }
-        else {
-            CCTextureCache::get()->addImage(png.c_str(), false);
-            CCSpriteFrameCache::get()->addSpriteFramesWithFile(plist.c_str());
-        }
+        sheets.push_back({ .png = std::move(pngPath), .plist = std::move(plistPath) });
+    }
+    return sheets;
+}
+
+static void loadSpritesheet(Loader::Impl::SpritesheetToLoad& sheet) {
+    CCTexture2D* texture;
+    if (sheet.image) {
+        texture = CCTextureCache::get()->addUIImage(sheet.image, sheet.png.c_str());
+        sheet.image->release();
+        sheet.image = nullptr;
+    }
+    else {
+        texture = CCTextureCache::get()->addImage(sheet.png.c_str(), false);
+    }
+    if (texture) {
+        CCSpriteFrameCache::get()->addSpriteFramesWithFile(sheet.plist.c_str(), texture);
+    }
+    else {
+        CCSpriteFrameCache::get()->addSpriteFramesWithFile(sheet.plist.c_str());
+    }
+}
+
+void Loader::Impl::updateModResources(Mod* mod) {
+    auto sheets = this->resolveModSpritesheets(mod);
+
+    // only thing needs previous setup is spritesheets
+    if (sheets.empty())
+        return;
+
+    log::debug("{}", mod->getID());
+    log::pushNest();
+
+    for (auto& sheet : sheets) {
+        log::debug("Adding sheet {}", sheet.png);
+        loadSpritesheet(sheet);
     }
 
     log::popNest();
 }
 
+namespace {
+    struct AsyncResourceLoad {
+        std::vector<Loader::Impl::SpritesheetToLoad> sheets;
+        std::mutex mutex;
+        // indices of sheets that have been decoded and are waiting for upload
+        std::deque<size_t> decoded;
+        size_t loaded = 0;
+        utils::MiniFunction<void(size_t, size_t)> progress;
+        utils::MiniFunction<void()> then;
+    };
+}
+
+// uploading is the part that has to happen on the main thread, so it is
+// spread over frames to keep the loading screen responsive
+static constexpr auto RESOURCE_UPLOAD_FRAME_BUDGET = std::chrono::milliseconds(8);
+
+static void uploadDecodedSpritesheets(std::shared_ptr<AsyncResourceLoad> load) {
+    auto begin = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - begin < RESOURCE_UPLOAD_FRAME_BUDGET) {
+        size_t index;
+        {
+            std::lock_guard lock(load->mutex);
+            if (load->decoded.empty()) break;
+            index = load->decoded.front();
+            load->decoded.pop_front();
+        }
+        loadSpritesheet(load->sheets[index]);
+        load->loaded += 1;
+    }
+
+    if (load->loaded < load->sheets.size()) {
+        load->progress(load->loaded, load->sheets.size());
+        Loader::get()->queueInMainThread([load]() {
+            uploadDecodedSpritesheets(load);
+        });
+        return;
+    }
+    log::debug("Loaded {} spritesheets", load->sheets.size());
+    load->then();
+}
+
+void Loader::Impl::updateResourcesAsync(
+    bool forceReload,
+    utils::MiniFunction<void(size_t, size_t)> progress,
+    utils::MiniFunction<void()> then
+) {
+    log::debug("Adding resources");
+    auto load = std::make_shared<AsyncResourceLoad>();
+    load->progress = std::move(progress);
+    load->then = std::move(then);
+
+    for (auto const& [_, mod] : m_mods) {
+        if (!forceReload && ModImpl::getImpl(mod)->m_resourcesLoaded)
+            continue;
+        auto sheets = this->resolveModSpritesheets(mod);
+        std::move(sheets.begin(), sheets.end(), std::back_inserter(load->sheets));
+        ModImpl::getImpl(mod)->m_resourcesLoaded = true;
+    }
+
+    if (load->sheets.empty()) {
+        return load->then();
+    }
+
+    std::thread([load]() {
+        thread::setName("Resource Decoder");
+
+        std::atomic_size_t next = 0;
+        auto decodeNext = [&]() {
+            for (auto i = next++; i < load->sheets.size(); i = next++) {
+                auto& sheet = load->sheets[i];
+                auto image = new CCImage();
+                if (!image->initWithImageFileThreadSafe(sheet.png.c_str())) {
+                    // loadSpritesheet falls back to loading it on the main thread
+                    image->release();
+                    image = nullptr;
+                }
+                std::lock_guard lock(load->mutex);
+                sheet.image = image;
+                load->decoded.push_back(i);
+            }
+        };
+        auto workerCount = std::min<size_t>(
+            load->sheets.size(), std::clamp(std::thread::hardware_concurrency(), 1u, 4u)
+        );
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < workerCount; i++) {
+            workers.emplace_back([&]() {
+                thread::setName("Resource Decoder Worker");
+                decodeNext();
+            });
+        }
+        decodeNext();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }).detach();
+
+    Loader::get()->queueInMainThread([load]() {
+        uploadDecodedSpritesheets(load);
+    });
+}
+
 void Loader::Impl::addProblem(LoadProblem const& problem) {
     if (std::holds_alternative<Mod*>(problem.cause)) {
         auto mod = std::get<Mod*>(problem.cause);
         ModImpl::getImpl(mod)->m_problems.push_back(problem);
     }
+    else if (std::holds_alternative<ModMetadata>(problem.cause)) {
+        m_problemModIDs.insert(std::get<ModMetadata>(problem.cause).getID());
+    }
     m_problems.push_back(problem);
 }
 
+void Loader::Impl::endPhase(std::string const& name) {
+    auto now = std::chrono::high_resolution_clock::now();
+    m_phaseTimes.emplace_back(
+        name, std::chrono::duration_cast<std::chrono::microseconds>(now - m_phaseBegin)
+    );
+    m_phaseBegin = now;
+}
+
+void Loader::Impl::logPhaseTimes() {
+    std::string times;
+    for (auto const& [name, time] : m_phaseTimes) {
+        if (!times.empty()) {
+            times += ", ";
+        }
+        times += fmt::format("{} {:.2f}ms", name, static_cast<double>(time.count()) / 1000.0);
+    }
+    log::info("Refreshed {} mods ({})", m_mods.size(), times);
+}
+
 // Dependencies and refreshing
 
 void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
+    std::unordered_set<std::string> queuedIDs;
+    for (auto const& item : modQueue) {
+        queuedIDs.insert(item.getID());
+    }
     for (auto const& dir : m_modSearchDirectories) {
         log::debug("Searching {}", dir);
         log::pushNest();
@@ -285,9 +458,7 @@ void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
             log::debug("version: {}", modMetadata.getVersion());
             log::debug("early: {}", modMetadata.needsEarlyLoad() ? "yes" : "no");
 
-            if (std::find_if(modQueue.begin(), modQueue.end(), [&](auto& item) {
-                    return modMetadata.getID() == item.getID();
-                }) != modQueue.end()) {
+            if (!queuedIDs.insert(modMetadata.getID()).second) {
                 this->addProblem({
                     LoadProblem::Type::Duplicate,
                     modMetadata,
@@ -306,15 +477,16 @@ void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
 }
 
 void Loader::Impl::populateModList(std::vector<ModMetadata>& modQueue) {
-    std::vector<std::string> toRemove;
-    for (auto& [id, mod] : m_mods) {
-        if (mod->isInternal())
+    std::erase_if(m_modList, [](Mod* mod) {
+        return !mod->isInternal();
+    });
+    for (auto it = m_mods.begin(); it != m_mods.end();) {
+        if (it->second->isInternal()) {
+            ++it;
             continue;
-        delete mod;
-        toRemove.push_back(id);
-    }
-    for (auto const& id : toRemove) {
-        m_mods.erase(id);
+        }
+        delete it->second;
+        it = m_mods.erase(it);
     }
 
     for (auto const& metadata : modQueue) {
@@ -335,7 +507,9 @@ void Loader::Impl::populateModList(std::vector<ModMetadata>& modQueue) {
             continue;
         }
 
-        m_mods.insert({metadata.getID(), mod});
+        if (m_mods.insert({metadata.getID(), mod}).second) {
+            m_modList.push_back(mod);
+        }
 
         log::popNest();
     }
@@ -613,16 +787,11 @@ void Loader::Impl::findProblems() {
             }
         }
 
-        Mod* myEpicMod = mod; // clang fix
         // if the mod is not loaded but there are no problems related to it
         if (!mod->isEnabled() &&
             mod->shouldLoad() &&
-            !std::any_of(m_problems.begin(), m_problems.end(), [myEpicMod](auto& item) {
-                return std::holds_alternative<ModMetadata>(item.cause) &&
-                    std::get<ModMetadata>(item.cause).getID() == myEpicMod->getID() ||
-                    std::holds_alternative<Mod*>(item.cause) &&
-                    std::get<Mod*>(item.cause) == myEpicMod;
-            })) {
+            ModImpl::getImpl(mod)->m_problems.empty() &&
+            !m_problemModIDs.contains(id)) {
             this->addProblem({
                 LoadProblem::Type::Unknown,
                 mod,
@@ -646,8 +815,11 @@ void Loader::Impl::refreshModGraph() {
     }
 
     auto begin = std::chrono::high_resolution_clock::now();
+    m_phaseBegin = begin;
+    m_phaseTimes.clear();
 
     m_problems.clear();
+    m_problemModIDs.clear();
 
     m_loadingState = LoadingState::Queue;
     log::debug("Queueing mods");
@@ -655,6 +827,7 @@ void Loader::Impl::refreshModGraph() {
     std::vector<ModMetadata> modQueue;
     this->queueMods(modQueue);
     log::popNest();
+    this->endPhase("queue");
 
     m_loadingState = LoadingState::List;
     log::debug("Populating mod list");
@@ -662,12 +835,14 @@ void Loader::Impl::refreshModGraph() {
     this->populateModList(modQueue);
     modQueue.clear();
     log::popNest();
+    this->endPhase("list");
 
     m_loadingState = LoadingState::Graph;
     log::debug("Building mod graph");
     log::pushNest();
     this->buildModGraph();
     log::popNest();
+    this->endPhase("graph");
 
     m_loadingState = LoadingState::EarlyMods;
     log::debug("Loading early mods");
@@ -676,6 +851,7 @@ void Loader::Impl::refreshModGraph() {
         this->loadModGraph(dep, true);
     }
     log::popNest();
+    this->endPhase("early mods");
 
     auto end = std::chrono::high_resolution_clock::now();
     auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
@@ -726,16 +902,20 @@ void Loader::Impl::continueRefreshModGraph() {
             m_loadingState = LoadingState::Problems;
             [[fallthrough]];
         case LoadingState::Problems:
+            // includes the frames spent waiting for mods to unzip
+            this->endPhase("mods");
             log::debug("Finding problems");
             log::pushNest();
             this->findProblems();
             log::popNest();
+            this->endPhase("problems");
             m_loadingState = LoadingState::Done;
             {
                 auto end = std::chrono::high_resolution_clock::now();
                 auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - m_timerBegin).count();
                 log::info("Took {}s", static_cast<float>(time) / 1000.f);
             }
+            this->logPhaseTimes();
             break;
         default:
             m_loadingState = LoadingState::Done;
@@ -762,6 +942,7 @@ void Loader::Impl::forceReset() {
         delete mod;
     }
     m_mods.clear();
+    m_modList.clear();
     log::Logger::get()->clear();
     ghc::filesystem::remove_all(dirs::getModRuntimeDir());
     ghc::filesystem::remove_all(dirs::getTempDir());
@@ -830,20 +1011,19 @@ void Loader::Impl::releaseNextMod() {
 // e.g. "--geode:arg=My spaced value"
 void Loader::Impl::initLaunchArguments() {
     auto launchStr = this->getLaunchCommand();
-    auto args = string::split(launchStr, " ");
-    for (const auto& arg : args) {
+    for (auto arg : string::splitView(launchStr, " ")) {
         if (!arg.starts_with(LAUNCH_ARG_PREFIX)) {
             continue;
         }
         auto pair = arg.substr(LAUNCH_ARG_PREFIX.size());
         auto sep = pair.find('=');
-        if (sep == std::string::npos) {
-            m_launchArgs.insert({ pair, "true" });
+        if (sep == std::string_view::npos) {
+            m_launchArgs.insert({ std::string(pair), "true" });
             continue;
         }
         auto key = pair.substr(0, sep);
         auto value = pair.substr(sep + 1);
-        m_launchArgs.insert({ key, value });
+        m_launchArgs.insert({ std::string(key), std::string(value) });
     }
     for (const auto& pair : m_launchArgs) {
         log::debug("Loaded '{}' as '{}'", pair.first, pair.second);
@@ -36,7 +36,20 @@ namespace geode {
 
         std::vector<ghc::filesystem::path> m_modSearchDirectories;
         std::vector<LoadProblem> m_problems;
-        std::unordered_map<std::string, Mod*> m_mods;
+        // ids of mods whose metadata has a problem, so checking whether a mod
+        // has problems doesn't have to go through all of them
+        std::unordered_set<std::string> m_problemModIDs;
+        // transparent so mods can be looked up with a std::string_view
+        struct ModIDHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view id) const noexcept {
+                return std::hash<std::string_view>()(id);
+            }
+        };
+        std::unordered_map<std::string, Mod*, ModIDHash, std::equal_to<>> m_mods;
+        // the same mods in the order they were added, for listing them
+        // without copying the map
+        std::vector<Mod*> m_modList;
         std::deque<Mod*> m_modsToLoad;
         std::vector<ghc::filesystem::path> m_texturePaths;
         bool m_isSetup = false;
@@ -63,6 +76,12 @@ namespace geode {
         std::unordered_map<std::string, std::string> m_launchArgs;
 
         std::chrono::time_point<std::chrono::high_resolution_clock> m_timerBegin;
+        std::chrono::time_point<std::chrono::high_resolution_clock> m_phaseBegin;
+        // how long each phase of the last mod graph refresh took
+        std::vector<std::pair<std::string, std::chrono::microseconds>> m_phaseTimes;
+
+        void endPhase(std::string const& name);
+        void logPhaseTimes();
 
         std::string getGameVersion();
         bool isForwardCompatMode();
@@ -83,7 +102,14 @@ namespace geode {
 
         void createDirectories();
 
+        struct SpritesheetToLoad {
+            std::string png;
+            std::string plist;
+            cocos2d::CCImage* image = nullptr;
+        };
+
         void updateModResources(Mod* mod);
+        std::vector<SpritesheetToLoad> resolveModSpritesheets(Mod* mod);
         void addSearchPaths();
         void addNativeBinariesPath(ghc::filesystem::path const& path);
 
@@ -106,10 +132,11 @@ namespace geode {
         void refreshModGraph();
         void continueRefreshModGraph();
 
-        bool isModInstalled(std::string const& id) const;
-        Mod* getInstalledMod(std::string const& id) const;
-        bool isModLoaded(std::string const& id) const;
-        Mod* getLoadedMod(std::string const& id) const;
+        Mod* findMod(std::string_view id) const;
+        bool isModInstalled(std::string_view id) const;
+        Mod* getInstalledMod(std::string_view id) const;
+        bool isModLoaded(std::string_view id) const;
+        Mod* getLoadedMod(std::string_view id) const;
         std::vector<Mod*> getAllMods();
         std::vector<LoadProblem> getProblems() const;
 
@@ -122,6 +149,19 @@ namespace geode {
         bool getLaunchFlag(std::string_view const name) const;
 
         void updateResources(bool forceReload);
+        /**
+         * Load mod resources without blocking the main thread. Spritesheet
+         * images are decoded on worker threads and uploaded to the GPU in
+         * small batches every frame
+         * @param progress Called on the main thread with the amount of
+         * loaded and total spritesheets
+         * @param then Called on the main thread once everything is loaded
+         */
+        void updateResourcesAsync(
+            bool forceReload,
+            utils::MiniFunction<void(size_t, size_t)> progress,
+            utils::MiniFunction<void()> then
+        );
 
         void queueInMainThread(const ScheduledFunction& func);
         void executeMainThreadQueue();
@@ -2,6 +2,7 @@
 #include "LoaderImpl.hpp"
 #include "ModMetadataImpl.hpp"
 #include "HookImpl.hpp"
+#include "HookProfiler.hpp"
 #include "PatchImpl.hpp"
 #include "about.hpp"
 #include "console.hpp"
@@ -738,6 +739,9 @@ ModJson Mod::Impl::getRuntimeInfo() const {
     obj["temp-dir"] = this->getTempDir();
     obj["save-dir"] = this->getSaveDir();
     obj["config-dir"] = this->getConfigDir(false);
+    if (auto profile = HookProfiler::get()->getModInfo(m_self)) {
+        obj["profile"] = profile.value();
+    }
     json["runtime"] = obj;
 
     return json;
@@ -788,9 +792,9 @@ Mod* Loader::Impl::getInternalMod() {
     auto& mod = Mod::sharedMod<>;
     if (mod)
         return mod;
-    if (m_mods.contains("geode.loader")) {
+    if (auto internal = this->findMod("geode.loader")) {
         log::warn("Something went wrong and Mod::sharedMod<> got unset after the internal mod was created! Setting sharedMod back...");
-        mod = m_mods["geode.loader"];
+        mod = internal;
         return mod;
     }
     auto infoRes = getModImplInfo();
@@ -809,6 +813,7 @@ Mod* Loader::Impl::getInternalMod() {
     }
     mod->m_impl->m_enabled = true;
     m_mods.insert({ mod->getID(), mod });
+    m_modList.push_back(mod);
     return mod;
 }
 
@@ -10,9 +10,53 @@
 
 #include "ModMetadataImpl.hpp"
 #include "LoaderImpl.hpp"
+#include <utils/JsonSchema.hpp>
 
 using namespace geode::prelude;
 
+// the keys read by createFromSchemaV010. the platform-specific parts are
+// still checked there, as is everything about settings, since each setting
+// type has its own keys
+static JsonSchema const& getModJsonSchema() {
+    using Type = matjson::Type;
+    static auto const schema = JsonSchema::object({
+        { "geode", JsonSchema::of(Type::String), true },
+        { "gd", JsonSchema::any() },
+        { "tags", JsonSchema::any() },
+        { "id", JsonSchema::of(Type::String), true },
+        { "version", JsonSchema::any(), true },
+        { "name", JsonSchema::of(Type::String), true },
+        { "developer", JsonSchema::of(Type::String) },
+        { "developers", JsonSchema::array(JsonSchema::of(Type::String)) },
+        { "description", JsonSchema::of(Type::String) },
+        { "repository", JsonSchema::of(Type::String) },
+        { "early-load", JsonSchema::of(Type::Bool) },
+        { "api", JsonSchema::any() },
+        // dependencies for other platforms are skipped before their required
+        // keys are checked
+        { "dependencies", JsonSchema::array(JsonSchema::object({
+            { "id", JsonSchema::of(Type::String) },
+            { "version", JsonSchema::any() },
+            { "importance", JsonSchema::any() },
+            { "platforms", JsonSchema::array(JsonSchema::of(Type::String)) },
+        })) },
+        { "incompatibilities", JsonSchema::array(JsonSchema::object({
+            { "id", JsonSchema::of(Type::String), true },
+            { "version", JsonSchema::any(), true },
+            { "importance", JsonSchema::any() },
+        })) },
+        { "settings", JsonSchema::of(Type::Object) },
+        { "resources", JsonSchema::object({
+            { "spritesheets", JsonSchema::of(Type::Object) },
+        }, false) },
+        { "issues", JsonSchema::object({
+            { "info", JsonSchema::of(Type::String), true },
+            { "url", JsonSchema::of(Type::String) },
+        }, false) },
+    });
+    return schema;
+}
+
 ModMetadata::Impl& ModMetadataImpl::getImpl(ModMetadata& info)  {
     return *info.m_impl;
 }
@@ -93,11 +137,12 @@ Result<ModMetadata> ModMetadata::Impl::createFromSchemaV010(ModJson const& rawJs
     }
     catch (...) { }
 
+    GEODE_UNWRAP(getModJsonSchema().validate(impl->m_rawJSON, checkerRoot));
+
     JsonChecker checker(impl->m_rawJSON);
     auto root = checker.root(checkerRoot).obj();
 
     root.needs("geode").into(impl->m_geodeVersion);
-    root.addKnownKey("gd");
 
     // Check GD version
     // (use rawJson because i dont like JsonMaybeValue)
@@ -130,9 +175,6 @@ Result<ModMetadata> ModMetadata::Impl::createFromSchemaV010(ModJson const& rawJs
         return Err("[mod.json] is missing target GD version");
     }
 
-    // don't think its used locally yet
-    root.addKnownKey("tags"); 
-
     root.needs("id")
         // todo: make this use validateID in full 2.0.0 release
         .validate(MiniFunction<bool(std::string const&)>(&ModMetadata::Impl::validateOldID))
@@ -195,7 +237,6 @@ Result<ModMetadata> ModMetadata::Impl::createFromSchemaV010(ModJson const& rawJs
         obj.needs("id").validate(MiniFunction<bool(std::string const&)>(&ModMetadata::Impl::validateOldID)).into(dependency.id);
         obj.needs("version").into(dependency.version);
         obj.has("importance").into(dependency.importance);
-        obj.checkUnknownKeys();
 
         // if (isDeprecatedIDForm(dependency.id)) {
         //     log::warn(
@@ -215,7 +256,6 @@ Result<ModMetadata> ModMetadata::Impl::createFromSchemaV010(ModJson const& rawJs
         obj.needs("id").validate(MiniFunction<bool(std::string const&)>(&ModMetadata::Impl::validateOldID)).into(incompatibility.id);
         obj.needs("version").into(incompatibility.version);
         obj.has("importance").into(incompatibility.importance);
-        obj.checkUnknownKeys();
 
         impl->m_incompatibilities.push_back(incompatibility);
     }
@@ -258,7 +298,6 @@ Result<ModMetadata> ModMetadata::Impl::createFromSchemaV010(ModJson const& rawJs
     if (checker.isError()) {
         return Err(checker.getError());
     }
-    root.checkUnknownKeys();
 
     return Ok(info);
 }
@@ -368,10 +407,15 @@ Result<ModMetadata> ModMetadata::Impl::createFromGeodeZip(file::Unzip& unzip) {
 }
 
 Result<> ModMetadata::Impl::addSpecialFiles(file::Unzip& unzip) {
+    return this->addSpecialFiles(unzip, ghc::filesystem::path());
+}
+
+Result<> ModMetadata::Impl::addSpecialFiles(file::Unzip& unzip, ghc::filesystem::path const& dir) {
     // unzip known MD files
     for (auto& [file, target] : this->getSpecialFiles()) {
-        if (unzip.hasEntry(file)) {
-            GEODE_UNWRAP_INTO(auto data, unzip.extract(file).expect("Unable to extract \"{}\"", file));
+        auto entry = dir / file;
+        if (unzip.hasEntry(entry)) {
+            GEODE_UNWRAP_INTO(auto data, unzip.extract(entry).expect("Unable to extract \"{}\"", file));
             *target = sanitizeDetailsData(std::string(data.begin(), data.end()));
         }
     }
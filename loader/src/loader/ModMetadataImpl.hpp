@@ -51,6 +51,10 @@ namespace geode {
 
         Result<> addSpecialFiles(ghc::filesystem::path const& dir);
         Result<> addSpecialFiles(utils::file::Unzip& zip);
+        /**
+         * Add the special files from a directory inside a zip
+         */
+        Result<> addSpecialFiles(utils::file::Unzip& zip, ghc::filesystem::path const& dir);
 
         std::vector<std::pair<std::string, std::optional<std::string>*>> getSpecialFiles();
     };
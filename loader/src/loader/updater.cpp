@@ -3,6 +3,9 @@
 #include <Geode/loader/Index.hpp>
 #include <resources.hpp>
 #include <hash.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <utility>
 #include "LoaderImpl.hpp"
 #include "ModMetadataImpl.hpp"
@@ -210,10 +213,52 @@ void updater::downloadLoaderResources(bool useLatestRelease) {
         });
 }
 
-bool updater::verifyLoaderResources() {
-    static std::optional<bool> CACHED = std::nullopt;
-    if (CACHED.has_value()) {
-        return CACHED.value();
+struct ResourceToVerify {
+    std::string name;
+    ghc::filesystem::path path;
+    std::string size;
+    std::string modified;
+    std::string hash;
+};
+
+static std::optional<bool> s_resourcesVerified;
+
+static void finishVerifyingResources(
+    std::vector<ResourceToVerify> const& resources,
+    utils::MiniFunction<void(bool)> const& then
+) {
+    // remember the hashes so unchanged files don't need to be rehashed
+    // on the next launch
+    auto cache = matjson::Object();
+    for (auto const& resource : resources) {
+        auto entry = matjson::Object();
+        entry["size"] = resource.size;
+        entry["modified"] = resource.modified;
+        entry["hash"] = resource.hash;
+        cache[resource.name] = entry;
+    }
+    Mod::get()->setSavedValue("resource-hash-cache", matjson::Value(cache));
+
+    for (auto const& resource : resources) {
+        auto const& expected = LOADER_RESOURCE_HASHES.at(resource.name);
+        if (resource.hash != expected) {
+            log::debug(
+                "Resource hash mismatch: {} ({}, {})",
+                resource.name, resource.hash.substr(0, 7), expected.substr(0, 7)
+            );
+            updater::downloadLoaderResources();
+            s_resourcesVerified = false;
+            return then(false);
+        }
+    }
+
+    s_resourcesVerified = true;
+    then(true);
+}
+
+void updater::verifyLoaderResources(utils::MiniFunction<void(bool)> then) {
+    if (s_resourcesVerified.has_value()) {
+        return then(s_resourcesVerified.value());
     }
 
     // geode/resources/geode.loader
@@ -226,7 +271,7 @@ bool updater::verifyLoaderResources() {
     )) {
         log::debug("Resources directory does not exist");
         updater::downloadLoaderResources(true);
-        return false;
+        return then(false);
     }
 
     // TODO: actually have a proper way to disable checking resources
@@ -235,39 +280,91 @@ bool updater::verifyLoaderResources() {
         // this is kind of a hack, but it's the easiest way to prevent
         // auto update while developing
         log::debug("Not updating resources since dont-update.txt exists");
-        return true;
+        return then(true);
     }
 
-    // make sure every file was covered
-    size_t coverage = 0;
+    auto cache = Mod::get()->getSavedValue<matjson::Value>("resource-hash-cache");
 
-    // verify hashes
+    std::vector<ResourceToVerify> resources;
+    std::vector<size_t> toHash;
     for (auto& file : ghc::filesystem::directory_iterator(resourcesDir)) {
         auto name = file.path().filename().string();
         // skip unknown files
         if (!LOADER_RESOURCE_HASHES.count(name)) {
             continue;
         }
-        // verify hash
-        // if we hash anything other than text, change this
-        auto hash = calculateSHA256Text(file.path());
-        const auto& expected = LOADER_RESOURCE_HASHES.at(name);
-        if (hash != expected) {
-            log::debug("Resource hash mismatch: {} ({}, {})", name, hash.substr(0, 7), expected.substr(0, 7));
-            updater::downloadLoaderResources();
-            return false;
+        std::error_code sizeError;
+        std::error_code modifiedError;
+        auto size = ghc::filesystem::file_size(file.path(), sizeError);
+        auto modified = ghc::filesystem::last_write_time(file.path(), modifiedError);
+
+        ResourceToVerify resource {
+            .name = name,
+            .path = file.path(),
+            .size = std::to_string(size),
+            .modified = std::to_string(modified.time_since_epoch().count()),
+        };
+        std::optional<std::string> cachedHash;
+        if (!sizeError && !modifiedError && cache.is_object() && cache.contains(name) && cache[name].is_object()) {
+            auto& entry = cache[name];
+            if (
+                entry.try_get<std::string>("size") == resource.size &&
+                entry.try_get<std::string>("modified") == resource.modified
+            ) {
+                cachedHash = entry.try_get<std::string>("hash");
+            }
+        }
+        if (cachedHash) {
+            resource.hash = cachedHash.value();
+        }
+        else {
+            toHash.push_back(resources.size());
         }
-        coverage += 1;
+        resources.push_back(std::move(resource));
     }
 
     // make sure every file was found
-    if (coverage != LOADER_RESOURCE_HASHES.size()) {
+    if (resources.size() != LOADER_RESOURCE_HASHES.size()) {
         log::debug("Resource coverage mismatch");
         updater::downloadLoaderResources();
-        return false;
+        return then(false);
     }
 
-    return true;
+    if (toHash.empty()) {
+        return finishVerifyingResources(resources, then);
+    }
+
+    log::debug("Hashing {} changed resources", toHash.size());
+    std::thread([resources = std::move(resources), toHash = std::move(toHash), then]() mutable {
+        thread::setName("Resource Verification");
+
+        // if we hash anything other than text, change this
+        std::atomic_size_t next = 0;
+        auto hashNext = [&]() {
+            for (auto i = next++; i < toHash.size(); i = next++) {
+                auto& resource = resources[toHash[i]];
+                resource.hash = calculateSHA256Text(resource.path);
+            }
+        };
+        auto workerCount = std::min<size_t>(
+            toHash.size(), std::clamp(std::thread::hardware_concurrency(), 1u, 4u)
+        );
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < workerCount; i++) {
+            workers.emplace_back([&]() {
+                thread::setName("Resource Verification Worker");
+                hashNext();
+            });
+        }
+        hashNext();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        Loader::get()->queueInMainThread([resources = std::move(resources), then]() {
+            finishVerifyingResources(resources, then);
+        });
+    }).detach();
 }
 
 void updater::downloadLoaderUpdate(std::string const& url) {
@@ -42,7 +42,14 @@ namespace geode::updater {
         bool force = false
     );
 
-    bool verifyLoaderResources();
+    /**
+     * Verify the hashes of the loader resources, downloading them again if
+     * they are missing or outdated. Files that have changed since the last
+     * check are hashed on worker threads
+     * @param then Called on the main thread with whether the resources are
+     * up to date
+     */
+    void verifyLoaderResources(utils::MiniFunction<void(bool)> then);
     void checkForLoaderUpdates();
     bool isNewUpdateDownloaded();
 }
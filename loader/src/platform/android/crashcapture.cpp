@@ -0,0 +1,432 @@
+#include "crashcapture.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <ucontext.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char const* CAPTURE_HEADER = "geode-crash 1";
+    constexpr size_t MAX_FRAMES = 64;
+    constexpr size_t MAX_REGISTERS = 40;
+    // big enough for a few thousand mappings, which GD with a bunch of mods
+    // does get close to
+    constexpr size_t MAPS_SIZE = 1024 * 1024;
+    constexpr size_t ALT_STACK_SIZE = 64 * 1024;
+    constexpr int SIGNALS[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT, SIGTRAP };
+    constexpr size_t SIGNAL_COUNT = sizeof(SIGNALS) / sizeof(SIGNALS[0]);
+
+    struct Register {
+        char const* name;
+        uintptr_t value;
+    };
+
+    // everything the handler touches is allocated up front
+    char s_path[PATH_MAX];
+    char s_maps[MAPS_SIZE];
+    size_t s_mapsSize = 0;
+    uintptr_t s_frames[MAX_FRAMES];
+    Register s_registers[MAX_REGISTERS];
+    alignas(16) char s_altStack[ALT_STACK_SIZE];
+    struct sigaction s_oldActions[SIGNAL_COUNT];
+    std::atomic_flag s_handling = ATOMIC_FLAG_INIT;
+
+    // Formats into a fixed buffer and writes it out whenever it fills up
+    class Writer final {
+        int m_fd;
+        char m_buffer[4096];
+        size_t m_size = 0;
+
+    public:
+        explicit Writer(int fd) : m_fd(fd) {}
+
+        ~Writer() {
+            this->flush();
+        }
+
+        void flush() {
+            size_t written = 0;
+            while (written < m_size) {
+                auto res = ::write(m_fd, m_buffer + written, m_size - written);
+                if (res < 0 && errno == EINTR) continue;
+                if (res <= 0) break;
+                written += res;
+            }
+            m_size = 0;
+        }
+
+        Writer& str(char const* str, size_t length) {
+            while (length) {
+                if (m_size == sizeof(m_buffer)) {
+                    this->flush();
+                }
+                auto count = sizeof(m_buffer) - m_size;
+                if (count > length) count = length;
+                std::memcpy(m_buffer + m_size, str, count);
+                m_size += count;
+                str += count;
+                length -= count;
+            }
+            return *this;
+        }
+
+        Writer& str(char const* str) {
+            return this->str(str, std::strlen(str));
+        }
+
+        Writer& hex(uintptr_t value) {
+            char digits[2 + sizeof(uintptr_t) * 2];
+            digits[0] = '0';
+            digits[1] = 'x';
+            for (size_t i = 0; i < sizeof(uintptr_t) * 2; i++) {
+                digits[sizeof(digits) - 1 - i] = "0123456789abcdef"[value & 0xf];
+                value >>= 4;
+            }
+            return this->str(digits, sizeof(digits));
+        }
+
+        Writer& dec(long value) {
+            char digits[24];
+            size_t pos = sizeof(digits);
+            bool negative = value < 0;
+            unsigned long abs = negative ? 0ul - static_cast<unsigned long>(value) : value;
+            do {
+                digits[--pos] = static_cast<char>('0' + abs % 10);
+                abs /= 10;
+            } while (abs);
+            if (negative) {
+                digits[--pos] = '-';
+            }
+            return this->str(digits + pos, sizeof(digits) - pos);
+        }
+    };
+
+    uintptr_t parseHex(char const*& it, char const* end) {
+        uintptr_t value = 0;
+        for (; it < end; it++) {
+            auto c = *it;
+            if (c >= '0' && c <= '9') value = value * 16 + (c - '0');
+            else if (c >= 'a' && c <= 'f') value = value * 16 + (c - 'a' + 10);
+            else break;
+        }
+        return value;
+    }
+
+    // Finds the readable mapping that contains `address` in the captured maps
+    bool findMapping(uintptr_t address, uintptr_t& start, uintptr_t& end) {
+        auto it = static_cast<char const*>(s_maps);
+        auto mapsEnd = s_maps + s_mapsSize;
+        while (it < mapsEnd) {
+            auto lineEnd = static_cast<char const*>(std::memchr(it, '\n', mapsEnd - it));
+            if (!lineEnd) lineEnd = mapsEnd;
+
+            start = parseHex(it, lineEnd);
+            if (it < lineEnd && *it == '-') it++;
+            end = parseHex(it, lineEnd);
+            bool readable = it + 1 < lineEnd && it[1] == 'r';
+            if (readable && start <= address && address < end) {
+                return true;
+            }
+            it = lineEnd + 1;
+        }
+        return false;
+    }
+
+    void readMaps() {
+        s_mapsSize = 0;
+        int fd = ::open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        while (s_mapsSize < MAPS_SIZE) {
+            auto res = ::read(fd, s_maps + s_mapsSize, MAPS_SIZE - s_mapsSize);
+            if (res < 0 && errno == EINTR) continue;
+            if (res <= 0) break;
+            s_mapsSize += res;
+        }
+        ::close(fd);
+    }
+
+    size_t captureRegisters(
+        ucontext_t* context, uintptr_t& pc, uintptr_t& lr, uintptr_t& fp, uintptr_t& sp, bool& walkable
+    ) {
+        size_t count = 0;
+        auto add = [&](char const* name, uintptr_t value) {
+            if (count < MAX_REGISTERS) {
+                s_registers[count++] = { name, value };
+            }
+        };
+        auto& mc = context->uc_mcontext;
+#if defined(__aarch64__)
+        static constexpr char const* NAMES[] = {
+            "x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10",
+            "x11", "x12", "x13", "x14", "x15", "x16", "x17", "x18", "x19", "x20",
+            "x21", "x22", "x23", "x24", "x25", "x26", "x27", "x28", "fp", "lr",
+        };
+        for (size_t i = 0; i < 31; i++) {
+            add(NAMES[i], mc.regs[i]);
+        }
+        add("sp", mc.sp);
+        add("pc", mc.pc);
+        add("pstate", mc.pstate);
+        pc = mc.pc;
+        lr = mc.regs[30];
+        fp = mc.regs[29];
+        sp = mc.sp;
+        walkable = true;
+#elif defined(__arm__)
+        add("r0", mc.arm_r0);
+        add("r1", mc.arm_r1);
+        add("r2", mc.arm_r2);
+        add("r3", mc.arm_r3);
+        add("r4", mc.arm_r4);
+        add("r5", mc.arm_r5);
+        add("r6", mc.arm_r6);
+        add("r7", mc.arm_r7);
+        add("r8", mc.arm_r8);
+        add("r9", mc.arm_r9);
+        add("r10", mc.arm_r10);
+        add("fp", mc.arm_fp);
+        add("ip", mc.arm_ip);
+        add("sp", mc.arm_sp);
+        add("lr", mc.arm_lr);
+        add("pc", mc.arm_pc);
+        add("cpsr", mc.arm_cpsr);
+        pc = mc.arm_pc;
+        lr = mc.arm_lr;
+        fp = mc.arm_fp;
+        sp = mc.arm_sp;
+        // thumb code doesn't keep a usable frame pointer chain
+        walkable = false;
+#elif defined(__x86_64__)
+        static constexpr std::pair<char const*, int> REGS[] = {
+            { "rax", REG_RAX }, { "rbx", REG_RBX }, { "rcx", REG_RCX }, { "rdx", REG_RDX },
+            { "rsi", REG_RSI }, { "rdi", REG_RDI }, { "rbp", REG_RBP }, { "rsp", REG_RSP },
+            { "r8", REG_R8 }, { "r9", REG_R9 }, { "r10", REG_R10 }, { "r11", REG_R11 },
+            { "r12", REG_R12 }, { "r13", REG_R13 }, { "r14", REG_R14 }, { "r15", REG_R15 },
+            { "rip", REG_RIP }, { "eflags", REG_EFL },
+        };
+        for (auto& [name, index] : REGS) {
+            add(name, static_cast<uintptr_t>(mc.gregs[index]));
+        }
+        pc = mc.gregs[REG_RIP];
+        lr = 0;
+        fp = mc.gregs[REG_RBP];
+        sp = mc.gregs[REG_RSP];
+        walkable = true;
+#elif defined(__i386__)
+        static constexpr std::pair<char const*, int> REGS[] = {
+            { "eax", REG_EAX }, { "ebx", REG_EBX }, { "ecx", REG_ECX }, { "edx", REG_EDX },
+            { "esi", REG_ESI }, { "edi", REG_EDI }, { "ebp", REG_EBP }, { "esp", REG_ESP },
+            { "eip", REG_EIP }, { "eflags", REG_EFL },
+        };
+        for (auto& [name, index] : REGS) {
+            add(name, static_cast<uintptr_t>(mc.gregs[index]));
+        }
+        pc = mc.gregs[REG_EIP];
+        lr = 0;
+        fp = mc.gregs[REG_EBP];
+        sp = mc.gregs[REG_ESP];
+        walkable = true;
+#else
+        pc = lr = fp = sp = 0;
+        walkable = false;
+#endif
+        return count;
+    }
+
+    // Walks the frame pointer chain, but only inside the stack mapping so a
+    // broken chain can't fault again
+    size_t captureFrames(uintptr_t pc, uintptr_t lr, uintptr_t fp, uintptr_t sp, bool walkable) {
+        size_t count = 0;
+        s_frames[count++] = pc;
+        if (lr) {
+            s_frames[count++] = lr;
+        }
+        uintptr_t stackStart, stackEnd;
+        // after a stack overflow sp points into the guard page below the
+        // stack, but the frame pointer is still inside it
+        if (!walkable || !(findMapping(sp, stackStart, stackEnd) || findMapping(fp, stackStart, stackEnd))) {
+            return count;
+        }
+        while (
+            count < MAX_FRAMES && fp >= stackStart && fp % sizeof(uintptr_t) == 0 &&
+            fp + 2 * sizeof(uintptr_t) <= stackEnd
+        ) {
+            auto frame = reinterpret_cast<uintptr_t const*>(fp);
+            if (!frame[1]) break;
+            s_frames[count++] = frame[1];
+            // the stack grows down, so callers' frames are always higher up
+            if (frame[0] <= fp) break;
+            fp = frame[0];
+        }
+        return count;
+    }
+
+    void capture(int signal, siginfo_t* info, ucontext_t* context) {
+        readMaps();
+
+        uintptr_t pc, lr, fp, sp;
+        bool walkable;
+        auto registerCount = captureRegisters(context, pc, lr, fp, sp, walkable);
+        auto frameCount = captureFrames(pc, lr, fp, sp, walkable);
+
+        int fd = ::open(s_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) return;
+        {
+            Writer out(fd);
+            out.str(CAPTURE_HEADER).str("\n");
+            out.str("signal ").dec(signal).str("\n");
+            out.str("code ").dec(info->si_code).str("\n");
+            out.str("address ").hex(reinterpret_cast<uintptr_t>(info->si_addr)).str("\n");
+            for (size_t i = 0; i < registerCount; i++) {
+                out.str("register ").str(s_registers[i].name).str(" ").hex(s_registers[i].value).str("\n");
+            }
+            for (size_t i = 0; i < frameCount; i++) {
+                out.str("frame ").hex(s_frames[i]).str("\n");
+            }
+            out.str("maps ").dec(static_cast<long>(s_mapsSize)).str("\n");
+            out.str(s_maps, s_mapsSize);
+        }
+        ::fsync(fd);
+        ::close(fd);
+    }
+
+    void handler(int signal, siginfo_t* info, void* vcontext) {
+        auto savedErrno = errno;
+
+        // only the first crash gets captured, if another thread crashes too
+        // it just goes straight to the previous handler
+        if (!s_handling.test_and_set()) {
+            capture(signal, info, static_cast<ucontext_t*>(vcontext));
+        }
+
+        for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+            if (SIGNALS[i] != signal) continue;
+            auto& old = s_oldActions[i];
+            sigaction(signal, &old, nullptr);
+            if (old.sa_flags & SA_SIGINFO) {
+                if (old.sa_sigaction) {
+                    old.sa_sigaction(signal, info, vcontext);
+                }
+            }
+            else if (old.sa_handler != SIG_DFL && old.sa_handler != SIG_IGN) {
+                old.sa_handler(signal);
+            }
+        }
+
+        errno = savedErrno;
+        // returning runs the faulting instruction again with the old handler
+        // in place, but signals that were sent have to be raised again
+        if (info->si_code <= 0) {
+            raise(signal);
+        }
+    }
+}
+
+bool crashcapture::install(char const* path) {
+    auto length = std::strlen(path);
+    if (length >= sizeof(s_path)) {
+        return false;
+    }
+    std::memcpy(s_path, path, length + 1);
+
+    // so stack overflows on this thread can still be captured
+    stack_t stack {};
+    stack.ss_sp = s_altStack;
+    stack.ss_size = sizeof(s_altStack);
+    sigaltstack(&stack, nullptr);
+
+    struct sigaction action {};
+    action.sa_sigaction = &handler;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+        if (sigaction(SIGNALS[i], &action, &s_oldActions[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::optional<crashcapture::Capture> crashcapture::read(char const* path) {
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+    if (!std::getline(file, line) || line != CAPTURE_HEADER) {
+        return std::nullopt;
+    }
+
+    auto parseNumber = [](std::string const& str, int base) {
+        return static_cast<uintptr_t>(std::strtoull(str.c_str(), nullptr, base));
+    };
+
+    Capture capture;
+    while (std::getline(file, line)) {
+        auto space = line.find(' ');
+        if (space == std::string::npos) continue;
+        auto key = line.substr(0, space);
+        auto value = line.substr(space + 1);
+
+        if (key == "signal") {
+            capture.signal = static_cast<int>(std::strtol(value.c_str(), nullptr, 10));
+        }
+        else if (key == "code") {
+            capture.code = static_cast<int>(std::strtol(value.c_str(), nullptr, 10));
+        }
+        else if (key == "address") {
+            capture.address = parseNumber(value, 16);
+        }
+        else if (key == "register") {
+            auto nameEnd = value.find(' ');
+            if (nameEnd == std::string::npos) continue;
+            capture.registers.push_back({ value.substr(0, nameEnd), parseNumber(value.substr(nameEnd + 1), 16) });
+        }
+        else if (key == "frame") {
+            capture.frames.push_back(parseNumber(value, 16));
+        }
+        else if (key == "maps") {
+            // the rest of the file, although it may have been cut short
+            capture.maps.resize(parseNumber(value, 10));
+            file.read(capture.maps.data(), capture.maps.size());
+            capture.maps.resize(file.gcount());
+            break;
+        }
+    }
+    if (!capture.signal) {
+        return std::nullopt;
+    }
+    return capture;
+}
+
+std::vector<crashcapture::Mapping> crashcapture::Capture::parseMappings() const {
+    std::vector<Mapping> mappings;
+    size_t pos = 0;
+    while (pos < maps.size()) {
+        auto lineEnd = maps.find('\n', pos);
+        if (lineEnd == std::string::npos) lineEnd = maps.size();
+        auto line = maps.substr(pos, lineEnd - pos);
+        pos = lineEnd + 1;
+
+        Mapping mapping;
+        char permissions[5] = {};
+        int pathStart = 0;
+        if (std::sscanf(
+            line.c_str(), "%" SCNxPTR "-%" SCNxPTR " %4s %" SCNxPTR " %*s %*s %n",
+            &mapping.start, &mapping.end, permissions, &mapping.offset, &pathStart
+        ) < 4) {
+            continue;
+        }
+        mapping.permissions = permissions;
+        if (pathStart > 0 && static_cast<size_t>(pathStart) < line.size()) {
+            mapping.path = line.substr(pathStart);
+        }
+        mappings.push_back(std::move(mapping));
+    }
+    return mappings;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Capturing crashes from a signal handler. Nothing here may allocate or take
+ * locks once a signal has arrived, so the handler only copies the registers,
+ * a frame pointer walk and /proc/self/maps into preallocated buffers and
+ * writes them to a file. The readable crashlog is made from that file on the
+ * next launch.
+ *
+ * Only depends on POSIX, so it can be built and tested on desktop Linux too
+ */
+namespace crashcapture {
+    /**
+     * Install handlers for fatal signals. The previous handlers are called
+     * after the capture has been written, so the system still gets to report
+     * the crash as well
+     * @param path Where to write the capture; copied, since nothing can be
+     * allocated once a crash happens
+     * @returns False if the path is too long or the handlers couldn't be
+     * installed
+     */
+    bool install(char const* path);
+
+    struct Mapping {
+        uintptr_t start;
+        uintptr_t end;
+        uintptr_t offset;
+        std::string permissions;
+        std::string path;
+    };
+
+    struct Capture {
+        int signal = 0;
+        int code = 0;
+        uintptr_t address = 0;
+        std::vector<std::pair<std::string, uintptr_t>> registers;
+        std::vector<uintptr_t> frames;
+        std::string maps;
+
+        std::vector<Mapping> parseMappings() const;
+    };
+
+    /**
+     * Read a capture written by the signal handler
+     */
+    std::optional<Capture> read(char const* path);
+}
@@ -67,37 +67,26 @@ void crashlog::setupPlatformHandlerPost() { }
 using namespace geode::prelude;
 
 #include <Geode/utils/string.hpp>
-#include <array>
-#include <thread>
 #include <ghc/fs_fwd.hpp>
-#include <execinfo.h>
 #include <dlfcn.h>
 #include <cxxabi.h>
-#include <algorithm>
 #include <link.h>
-#include <unwind.h>
-
 
 #include <jni.h>
 #include <Geode/cocos/platform/android/jni/JniHelper.h>
 
-#include "backtrace/execinfo.hpp"
+#include "crashcapture.hpp"
+
+static constexpr auto PENDING_CAPTURE_FILENAME = "pending-crash";
 
-static constexpr size_t FRAME_SIZE = 64;
-static std::mutex s_mutex;
-static std::condition_variable s_cv;
-static int s_signal = 0;
-static siginfo_t* s_siginfo = nullptr;
-static ucontext_t* s_context = nullptr;
-static size_t s_backtraceSize = 0;
-static std::array<void*, FRAME_SIZE> s_backtrace;
+static std::optional<crashcapture::Capture> s_capture;
 
-static std::string_view getSignalCodeString() {
-    switch(s_signal) {
+static std::string_view getSignalCodeString(int signal, int code) {
+    switch(signal) {
         case SIGSEGV: return "SIGSEGV: Segmentation Fault";
         case SIGINT: return "SIGINT: Interactive attention signal, (usually ctrl+c)";
         case SIGFPE:
-            switch(s_siginfo->si_code) {
+            switch(code) {
                 case FPE_INTDIV: return "SIGFPE: (integer divide by zero)";
                 case FPE_INTOVF: return "SIGFPE: (integer overflow)";
                 case FPE_FLTDIV: return "SIGFPE: (floating-point divide by zero)";
@@ -109,7 +98,7 @@ static std::string_view getSignalCodeString() {
                 default: return "SIGFPE: Arithmetic Exception";
             }
         case SIGILL:
-            switch(s_siginfo->si_code) {
+            switch(code) {
                 case ILL_ILLOPC: return "SIGILL: (illegal opcode)";
                 case ILL_ILLOPN: return "SIGILL: (illegal operand)";
                 case ILL_ILLADR: return "SIGILL: (illegal addressing mode)";
@@ -123,135 +112,120 @@ static std::string_view getSignalCodeString() {
         case SIGTERM: return "SIGTERM: a termination request was sent to the program";
         case SIGABRT: return "SIGABRT: usually caused by an abort() or assert()";
         case SIGBUS: return "SIGBUS: Bus error (bad memory access)";
+        case SIGTRAP: return "SIGTRAP: Trace/breakpoint trap";
         default: return "Unknown signal code";
     }
 }
 
-static std::string getImageName(void const* image) {
-    if (image == nullptr) {
-        return "<Unknown>";
+static crashcapture::Mapping const* mappingFromAddress(
+    std::vector<crashcapture::Mapping> const& mappings, uintptr_t address
+) {
+    for (auto& mapping : mappings) {
+        if (mapping.start <= address && address < mapping.end) {
+            return &mapping;
+        }
     }
-    std::string imageName;// = image->imageFilePath;
-    if (imageName.empty()) {
-        imageName = "<Unknown>";
+    return nullptr;
+}
+
+// where the library containing `mapping` was loaded in the crashed process
+static uintptr_t moduleBase(std::vector<crashcapture::Mapping> const& mappings, crashcapture::Mapping const& mapping) {
+    for (auto& other : mappings) {
+        if (other.path == mapping.path && other.offset == 0) {
+            return other.start;
+        }
     }
-    return imageName;
+    return mapping.start - mapping.offset;
 }
 
-static void const* imageFromAddress(void const* addr) {
-    if (addr == nullptr) {
+static Mod* modFromMapping(crashcapture::Mapping const* mapping) {
+    if (mapping == nullptr || mapping->path.empty()) {
         return nullptr;
     }
+    for (auto& mod : Loader::get()->getAllModsView()) {
+        if (mod->getBinaryPath().string() == mapping->path) {
+            return mod;
+        }
+    }
     return nullptr;
 }
 
-static Mod* modFromAddress(void const* addr) {
-    if (addr == nullptr) {
-        return nullptr;
+// The crashed process is gone, but if the same library is loaded in this one
+// its symbols can be looked up at the same offset
+static std::string symbolFromOffset(std::string const& path, uintptr_t offset) {
+    struct Search {
+        std::string const& path;
+        uintptr_t base = 0;
+    } search { path };
+    dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) {
+        auto search = static_cast<Search*>(data);
+        std::string_view name = info->dlpi_name ? info->dlpi_name : "";
+        if (name.empty()) return 0;
+        if (name == search->path || string::endsWith(search->path, fmt::format("/{}", name))) {
+            search->base = info->dlpi_addr;
+            return 1;
+        }
+        return 0;
+    }, &search);
+    if (!search.base) {
+        return "";
     }
-    return nullptr;
+
+    Dl_info info;
+    if (!dladdr(reinterpret_cast<void*>(search.base + offset), &info) || !info.dli_sname) {
+        return "";
+    }
+    int status;
+    auto demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    std::string name = status == 0 ? demangled : info.dli_sname;
+    free(demangled);
+    return fmt::format(
+        "{}+{:#x}", name, search.base + offset - reinterpret_cast<uintptr_t>(info.dli_saddr)
+    );
 }
 
-static std::string getInfo(void* address, Mod* faultyMod) {
+static std::string getInfo(
+    crashcapture::Capture const& capture, crashcapture::Mapping const* mapping, Mod* faultyMod
+) {
     std::stringstream stream;
-    stream << "Faulty Lib: " << getImageName(imageFromAddress(address)) << "\n";
+    stream << "Faulty Lib: " << (mapping && !mapping->path.empty() ? mapping->path : "<Unknown>") << "\n";
     stream << "Faulty Mod: " << (faultyMod ? faultyMod->getID() : "<Unknown>") << "\n";
-    stream << "Instruction Address: " << address << "\n";
-    stream << "Signal Code: " << std::hex << s_signal << " (" << getSignalCodeString() << ")" << std::dec << "\n";
+    stream << "Instruction Address: " << fmt::format("{:#x}", capture.frames.empty() ? 0 : capture.frames.front()) << "\n";
+    stream << "Fault Address: " << fmt::format("{:#x}", capture.address) << "\n";
+    stream << "Signal Code: " << std::hex << capture.signal << " ("
+        << getSignalCodeString(capture.signal, capture.code) << ")" << std::dec << "\n";
     return stream.str();
 }
 
-static struct sigaction oldActionSEGV;
-static struct sigaction oldActionBUS;
-static struct sigaction oldActionILL;
-
-extern "C" void signalHandler(int signal, siginfo_t* signalInfo, void* vcontext) {
-    auto context = reinterpret_cast<ucontext_t*>(vcontext);
-    s_backtraceSize = 0;
-    // s_backtraceSize = backtrace(s_backtrace.data(), FRAME_SIZE);
-
-    // for some reason this is needed, dont ask me why
-    // s_backtrace[1] = reinterpret_cast<void*>(context->uc_mcontext.fault_address);
-    // if (s_backtraceSize < FRAME_SIZE) {
-    //     s_backtrace[s_backtraceSize] = nullptr;
-    // }
-
-    {
-        std::unique_lock<std::mutex> lock(s_mutex);
-        s_signal = signal;
-        s_siginfo = signalInfo;
-        s_context = context;
-    }
-
-    s_cv.notify_all();
-    std::unique_lock<std::mutex> lock(s_mutex);
-    s_cv.wait(lock, [] { return s_signal == 0; });
-    // std::_Exit(EXIT_FAILURE);
-
-    switch (signal) {
-        case SIGSEGV:
-            sigaction(signal, &oldActionSEGV, nullptr);
-            oldActionSEGV.sa_sigaction(signal, signalInfo, vcontext);
-            break;
-        case SIGBUS:
-            sigaction(signal, &oldActionBUS, nullptr);
-            oldActionBUS.sa_sigaction(signal, signalInfo, vcontext);
-            break;
-        case SIGILL:
-            sigaction(signal, &oldActionILL, nullptr);
-            oldActionILL.sa_sigaction(signal, signalInfo, vcontext);
-            break;
-    }
-}
-
-static std::string getStacktrace() {
+static std::string getStacktrace(
+    crashcapture::Capture const& capture, std::vector<crashcapture::Mapping> const& mappings
+) {
     std::stringstream stacktrace;
-
-    if (s_backtraceSize == 0) {
-        return stacktrace.str();
-    }
-
-    auto messages = backtrace_symbols(s_backtrace.data(), s_backtraceSize);
-	if (s_backtraceSize < FRAME_SIZE) {
-		messages[s_backtraceSize] = nullptr;
-	}
-
-
-    for (int i = 1; i < s_backtraceSize; ++i) {
-        auto message = std::string(messages[i]);
-
-        // TODO: parse the message
-        stacktrace << message << "\n";
+    for (auto frame : capture.frames) {
+        auto mapping = mappingFromAddress(mappings, frame);
+        if (!mapping || mapping->path.empty()) {
+            stacktrace << fmt::format("- {:#x}\n", frame);
+            continue;
+        }
+        auto offset = frame - moduleBase(mappings, *mapping);
+        auto name = ghc::filesystem::path(mapping->path).filename().string();
+        stacktrace << fmt::format("- {}+{:#x}", name, offset);
+        if (auto symbol = symbolFromOffset(mapping->path, offset); !symbol.empty()) {
+            stacktrace << " (" << symbol << ")";
+        }
+        stacktrace << "\n";
     }
-
-    free(messages);
-
     return stacktrace.str();
 }
 
-static std::string getRegisters() {
+static std::string getRegisters(crashcapture::Capture const& capture) {
     std::stringstream registers;
-
+    for (auto& [name, value] : capture.registers) {
+        registers << fmt::format("{}: {:#x}\n", name, value);
+    }
     return registers.str();
 }
 
-static void handlerThread() {
-    std::unique_lock<std::mutex> lock(s_mutex);
-    s_cv.wait(lock, [] { return s_signal != 0; });
-
-    auto signalAddress = reinterpret_cast<void*>(s_context->uc_mcontext.fault_address);
-    Mod* faultyMod = modFromAddress(signalAddress);
-
-    auto text = crashlog::writeCrashlog(faultyMod, getInfo(signalAddress, faultyMod), getStacktrace(), getRegisters());
-
-    log::error("Geode crashed!\n{}", text);
-    
-    s_signal = 0;
-    s_cv.notify_all();
-
-    log::debug("Notified");
-}
-
 int writeAndGetPid() {
     auto pidFile = crashlog::getCrashLogDirectory() / "last-pid";
 
@@ -284,7 +258,7 @@ int writeAndGetPid() {
 }
 
 void printModsAndroid(std::stringstream& stream) {
-    auto mods = Loader::get()->getAllMods();
+    auto mods = Loader::get()->getAllModsView();
     if (mods.empty()) {
         stream << "<None>\n";
     }
@@ -297,50 +271,49 @@ void printModsAndroid(std::stringstream& stream) {
     }
 }
 
-void printMemoryMappings(std::stringstream& stream) {
-    std::ifstream processMappings("/proc/self/maps");
+static std::string s_result;
+bool crashlog::setupPlatformHandler() {
+    auto crashDirectory = crashlog::getCrashLogDirectory();
+    (void)utils::file::createDirectoryAll(crashDirectory);
+
+    // pick up whatever the last launch left behind before the new handler
+    // gets a chance to overwrite it
+    auto capturePath = crashDirectory / PENDING_CAPTURE_FILENAME;
+    s_capture = crashcapture::read(capturePath.string().c_str());
+    if (s_capture) {
+        s_lastLaunchCrashed = true;
+    }
+    std::error_code ec;
+    ghc::filesystem::remove(capturePath, ec);
 
-    std::string mapping;
-    while (std::getline(processMappings, mapping)) {
-        stream << mapping << "\n";
+    if (!crashcapture::install(capturePath.string().c_str())) {
+        return false;
     }
-}
 
-static std::string s_result;
-bool crashlog::setupPlatformHandler() {
-    (void)utils::file::createDirectoryAll(crashlog::getCrashLogDirectory());
-    
+    // the launcher can also give us the system's own crash report, which is
+    // nice to have but not required
     JniMethodInfo t;
-    
     if (JniHelper::getStaticMethodInfo(t, "com/erynd/launcher/utils/EryndUtils", "getLogcatCrashBuffer", "()Ljava/lang/String;")) {
         jstring stringResult = (jstring)t.env->CallStaticObjectMethod(t.classID, t.methodID);
 
-        s_result = JniHelper::jstring2string(stringResult);
+        auto logcat = JniHelper::jstring2string(stringResult);
 
         t.env->DeleteLocalRef(stringResult);
         t.env->DeleteLocalRef(t.classID);
 
-        if (s_result.empty()) {
-            return false;
+        auto lastPid = writeAndGetPid();
+        auto index = logcat.rfind(fmt::format("pid {}", lastPid));
+        if (index != std::string::npos) {
+            auto begin = logcat.substr(0, index).rfind("F/libc");
+            s_result = begin != std::string::npos ? logcat.substr(begin) : logcat;
+            s_lastLaunchCrashed = true;
         }
     }
-    else return false;
-
-    auto lastPid = writeAndGetPid();
-
-    auto index = s_result.rfind(fmt::format("pid {}", lastPid));
-    if (index != std::string::npos) {
-        auto begin = s_result.substr(0, index).rfind("F/libc");
-        if (begin != std::string::npos) {
-            s_result = s_result.substr(begin);
-        }
-        s_lastLaunchCrashed = true;
-    }
     return true;
 }
 
 void crashlog::setupPlatformHandlerPost() {
-    if (s_result.empty()) return;
+    if (!s_capture && s_result.empty()) return;
 
     std::stringstream ss;
     ss << "Geode crashed!\n";
@@ -348,14 +321,34 @@ void crashlog::setupPlatformHandlerPost() {
     ss << "\n== Geode Information ==\n";
     crashlog::printGeodeInfo(ss);
 
+    if (s_capture) {
+        auto mappings = s_capture->parseMappings();
+        auto mapping = s_capture->frames.empty() ?
+            nullptr : mappingFromAddress(mappings, s_capture->frames.front());
+        auto faultyMod = modFromMapping(mapping);
+
+        ss << "\n== Exception Information ==\n";
+        ss << getInfo(*s_capture, mapping, faultyMod);
+
+        ss << "\n== Stack Trace ==\n";
+        ss << getStacktrace(*s_capture, mappings);
+
+        ss << "\n== Register States ==\n";
+        ss << getRegisters(*s_capture);
+    }
+
     ss << "\n== Installed Mods ==\n";
     printModsAndroid(ss);
 
-    ss << "\n== Crash Report (Logcat) ==\n";
-    ss << s_result;
+    if (!s_result.empty()) {
+        ss << "\n== Crash Report (Logcat) ==\n";
+        ss << s_result;
+    }
 
-    ss << "\n== Process Mapping ==\n";
-    printMemoryMappings(ss);
+    if (s_capture) {
+        ss << "\n== Process Mapping ==\n";
+        ss << s_capture->maps;
+    }
 
     std::ofstream actualFile;
     actualFile.open(
@@ -363,6 +356,9 @@ void crashlog::setupPlatformHandlerPost() {
     );
     actualFile << ss.rdbuf() << std::flush;
     actualFile.close();
+
+    s_capture.reset();
+    s_result.clear();
 }
 
 #endif
@@ -148,7 +148,7 @@ static Mod* modFromAddress(void const* addr) {
         return Mod::get();
     }
 
-    for (auto& mod : Loader::get()->getAllMods()) {
+    for (auto& mod : Loader::get()->getAllModsView()) {
         if (!mod->isEnabled() || !ghc::filesystem::exists(mod->getBinaryPath())) {
             continue;
         }
@@ -25,6 +25,11 @@ using namespace geode::prelude;
 static bool g_lastLaunchCrashed = false;
 static bool g_symbolsInitialized = false;
 
+// how long to wait for the symbolized report before giving up on it; the
+// minimal record has already been written by then
+static constexpr DWORD SYMBOLIZE_TIMEOUT_MS = 10000;
+static constexpr size_t MAX_FRAMES = 128;
+
 static std::string getDateString(bool filesafe) {
     auto const now = std::time(nullptr);
     auto const tm = *std::localtime(&now);
@@ -82,7 +87,7 @@ static HMODULE handleFromAddress(void const* addr) {
 
 static Mod* modFromAddress(PVOID exceptionAddress) {
     auto modulePath = getModuleName(handleFromAddress(exceptionAddress), true);
-    for (auto& mod : Loader::get()->getAllMods()) {
+    for (auto& mod : Loader::get()->getAllModsView()) {
         if (mod->getBinaryPath() == modulePath) {
             return mod;
         }
@@ -90,7 +95,26 @@ static Mod* modFromAddress(PVOID exceptionAddress) {
     return nullptr;
 }
 
-static void printAddr(std::ostream& stream, void const* addr, bool fullPath = true) {
+// Loads a module into dbghelp the first time one of its addresses is looked
+// up, instead of invading the process and loading every module up front
+static DWORD64 CALLBACK getModuleBase(HANDLE process, DWORD64 address) {
+    if (auto base = SymGetModuleBase64(process, address)) {
+        return base;
+    }
+    auto module = handleFromAddress(reinterpret_cast<void const*>(address));
+    if (!module) {
+        return 0;
+    }
+    auto path = getModuleName(module, true);
+    auto base = static_cast<DWORD64>(reinterpret_cast<uintptr_t>(module));
+    // returns 0 with no error if the module was already loaded
+    if (!SymLoadModuleEx(process, nullptr, path.c_str(), nullptr, base, 0, nullptr, 0) && GetLastError() != ERROR_SUCCESS) {
+        return 0;
+    }
+    return base;
+}
+
+static void printAddr(std::ostream& stream, void const* addr, bool fullPath = true, bool symbolize = true) {
     HMODULE module = nullptr;
 
     if (GetModuleHandleEx(
@@ -102,7 +126,7 @@ static void printAddr(std::ostream& stream, void const* addr, bool fullPath = tr
         stream << getModuleName(module, fullPath) << " + " << std::hex << diff << std::dec;
 
         // log symbol if possible
-        if (g_symbolsInitialized) {
+        if (symbolize && g_symbolsInitialized) {
             // https://docs.microsoft.com/en-us/windows/win32/debug/retrieving-symbol-information-by-address
 
             DWORD64 displacement;
@@ -114,6 +138,7 @@ static void printAddr(std::ostream& stream, void const* addr, bool fullPath = tr
             symbolInfo->MaxNameLen = MAX_SYM_NAME;
 
             auto proc = GetCurrentProcess();
+            getModuleBase(proc, static_cast<DWORD64>(reinterpret_cast<uintptr_t>(addr)));
 
             if (SymFromAddr(
                     proc, static_cast<DWORD64>(reinterpret_cast<uintptr_t>(addr)), &displacement,
@@ -144,30 +169,40 @@ static void printAddr(std::ostream& stream, void const* addr, bool fullPath = tr
 }
 
 // https://stackoverflow.com/a/50208684/9124836
-static std::string getStacktrace(PCONTEXT context) {
-    std::stringstream stream;
+static std::vector<void*> walkStack(PCONTEXT context) {
+    std::vector<void*> frames;
     STACKFRAME64 stack;
     memset(&stack, 0, sizeof(STACKFRAME64));
 
+    // StackWalk64 modifies the context, and the registers are printed later
+    CONTEXT copy = *context;
+
     auto process = GetCurrentProcess();
     auto thread = GetCurrentThread();
-    stack.AddrPC.Offset = context->Eip;
+    stack.AddrPC.Offset = copy.Eip;
     stack.AddrPC.Mode = AddrModeFlat;
-    stack.AddrStack.Offset = context->Esp;
+    stack.AddrStack.Offset = copy.Esp;
     stack.AddrStack.Mode = AddrModeFlat;
-    stack.AddrFrame.Offset = context->Ebp;
+    stack.AddrFrame.Offset = copy.Ebp;
     stack.AddrFrame.Mode = AddrModeFlat;
 
-    // size_t frame = 0;
-    while (true) {
+    while (frames.size() < MAX_FRAMES) {
         if (!StackWalk64(
-                IMAGE_FILE_MACHINE_I386, process, thread, &stack, context, nullptr,
-                SymFunctionTableAccess64, SymGetModuleBase64, nullptr
+                IMAGE_FILE_MACHINE_I386, process, thread, &stack, &copy, nullptr,
+                SymFunctionTableAccess64, getModuleBase, nullptr
             ))
             break;
 
+        frames.push_back(reinterpret_cast<void*>(stack.AddrPC.Offset));
+    }
+    return frames;
+}
+
+static std::string getStacktrace(std::vector<void*> const& frames, bool symbolize) {
+    std::stringstream stream;
+    for (auto frame : frames) {
         stream << " - ";
-        printAddr(stream, reinterpret_cast<void*>(stack.AddrPC.Offset));
+        printAddr(stream, frame, true, symbolize);
         stream << std::endl;
     }
     return stream.str();
@@ -202,7 +237,7 @@ static std::add_const_t<std::decay_t<T>> rebaseAndCast(intptr_t base, U value) {
     return reinterpret_cast<std::add_const_t<std::decay_t<T>>>(base + (ptrdiff_t)(value));
 }
 
-static std::string getInfo(LPEXCEPTION_POINTERS info, Mod* faultyMod) {
+static std::string getInfo(LPEXCEPTION_POINTERS info, Mod* faultyMod, std::string const& threadName) {
     std::stringstream stream;
 
     if (info->ExceptionRecord->ExceptionCode == EH_EXCEPTION_NUMBER) {
@@ -284,21 +319,81 @@ static std::string getInfo(LPEXCEPTION_POINTERS info, Mod* faultyMod) {
     }
 
     // show the thread that crashed
-    stream << "Crashed thread: " << utils::thread::getName() << "\n";
+    stream << "Crashed thread: " << threadName << "\n";
     
     return stream.str();
 }
 
-static LONG WINAPI exceptionHandler(LPEXCEPTION_POINTERS info) {
-
-    SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+// Written before anything gets symbolized, so there's something to go on even
+// if symbolizing hangs or crashes again
+static std::string writeMinimalRecord(
+    LPEXCEPTION_POINTERS info, std::vector<void*> const& frames, std::string const& threadName
+) {
+    std::stringstream stream;
+    stream << getDateString(false) << "\n"
+        << "Whoopsies! An unhandled exception has occurred.\n"
+        << "\n== Exception Information ==\n"
+        << "Exception Code: " << std::hex << info->ExceptionRecord->ExceptionCode << " ("
+        << getExceptionCodeString(info->ExceptionRecord->ExceptionCode) << ")" << std::dec << "\n"
+        << "Exception Address: ";
+    printAddr(stream, info->ExceptionRecord->ExceptionAddress, true, false);
+    stream << "\n"
+        << "Crashed thread: " << threadName << "\n"
+        << "\n== Stack Trace ==\n"
+        << getStacktrace(frames, false)
+        << "\n== Register States ==\n"
+        << getRegisters(info->ContextRecord);
+
+    auto text = stream.str();
+    (void)utils::file::createDirectoryAll(crashlog::getCrashLogDirectory());
+    (void)utils::file::writeString(crashlog::getCrashLogDirectory() / "last-crashed", text);
+    return text;
+}
 
-    // init symbols so we can get some juicy debug info
-    g_symbolsInitialized = SymInitialize(static_cast<HMODULE>(GetCurrentProcess()), nullptr, true);
+struct CrashReport {
+    LPEXCEPTION_POINTERS info;
+    std::vector<void*> frames;
+    std::string threadName;
+    std::string text;
+};
+
+static DWORD WINAPI writeSymbolizedReport(LPVOID param) {
+    auto report = static_cast<CrashReport*>(param);
+    auto faultyMod = modFromAddress(report->info->ExceptionRecord->ExceptionAddress);
+    // this also empties the last-crashed file, since the minimal record
+    // isn't needed anymore
+    report->text = crashlog::writeCrashlog(
+        faultyMod, getInfo(report->info, faultyMod, report->threadName),
+        getStacktrace(report->frames, true), getRegisters(report->info->ContextRecord)
+    );
+    return 0;
+}
 
-    auto faultyMod = modFromAddress(info->ExceptionRecord->ExceptionAddress);
+static LONG WINAPI exceptionHandler(LPEXCEPTION_POINTERS info) {
+    // without invading the process this is cheap; modules are only loaded
+    // once they show up in the stack trace
+    if (!g_symbolsInitialized) {
+        SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+        g_symbolsInitialized = SymInitialize(GetCurrentProcess(), nullptr, false);
+    }
 
-    auto text = crashlog::writeCrashlog(faultyMod, getInfo(info, faultyMod), getStacktrace(info->ContextRecord), getRegisters(info->ContextRecord));
+    // the report is leaked on purpose, since the worker may still be using
+    // it if it times out
+    auto report = new CrashReport {
+        .info = info,
+        .frames = walkStack(info->ContextRecord),
+        .threadName = utils::thread::getName(),
+    };
+    auto text = writeMinimalRecord(info, report->frames, report->threadName);
+
+    // reading the PDBs can take a while, so do it on another thread and
+    // don't wait on it forever
+    if (auto thread = CreateThread(nullptr, 0, writeSymbolizedReport, report, 0, nullptr)) {
+        if (WaitForSingleObject(thread, SYMBOLIZE_TIMEOUT_MS) == WAIT_OBJECT_0) {
+            text = report->text;
+        }
+        CloseHandle(thread);
+    }
 
     MessageBoxA(nullptr, text.c_str(), "Geometry Dash Crashed", MB_ICONERROR);
 
@@ -319,6 +414,14 @@ bool crashlog::setupPlatformHandler() {
     auto lastCrashedFile = crashlog::getCrashLogDirectory() / "last-crashed";
     if (ghc::filesystem::exists(lastCrashedFile)) {
         g_lastLaunchCrashed = true;
+        // if the full report never got written, keep the minimal record
+        auto record = utils::file::readString(lastCrashedFile);
+        if (record && !record.unwrap().empty()) {
+            (void)utils::file::writeString(
+                crashlog::getCrashLogDirectory() / (getDateString(true) + "-minimal.log"),
+                record.unwrap()
+            );
+        }
         try {
             ghc::filesystem::remove(lastCrashedFile);
         }
@@ -1,12 +1,14 @@
 #include "info/ModInfoPopup.hpp"
 #include "list/ModListLayer.hpp"
 #include "settings/ModSettingsPopup.hpp"
+#include "LogoCache.hpp"
 
 #include <Geode/loader/Dirs.hpp>
 #include <Geode/loader/Index.hpp>
 #include <Geode/ui/GeodeUI.hpp>
 #include <Geode/ui/MDPopup.hpp>
 #include <Geode/utils/web.hpp>
+#include <cfloat>
 
 void geode::openModsList() {
     ModListLayer::scene();
@@ -83,57 +85,172 @@ CCNode* geode::createDefaultLogo(CCSize const& size) {
     return spr;
 }
 
-CCNode* geode::createModLogo(Mod* mod, CCSize const& size) {
-    CCNode* spr = mod == Mod::get() ?
-        CCSprite::createWithSpriteFrameName("geode-logo.png"_spr) :
-        CCSprite::create(fmt::format("{}/logo.png", mod->getID()).c_str());
-    if (!spr) spr = CCSprite::createWithSpriteFrameName("no-logo.png"_spr);
-    if (!spr) spr = CCLabelBMFont::create("N/A", "goldFont.fnt");
-    limitNodeSize(spr, size, 1.f, .01f);
-    spr->setPosition(size/2);
-    spr->setAnchorPoint({.5f, .5f});
+// installed mods and index items check their thumbnails against different
+// sources, so they can't share one even for the same version. The key names
+// the thumbnail file as well, so no colons
+static constexpr std::string_view INSTALLED_LOGO_PREFIX = "mod-";
+static constexpr std::string_view INDEX_LOGO_PREFIX = "index-";
 
-    auto node = CCNode::create();
-    node->addChild(spr);
-    node->setContentSize(size);
-    return node;
+static std::string getLogoKey(std::string_view prefix, ModMetadata const& metadata) {
+    return fmt::format("{}{}@{}", prefix, metadata.getID(), metadata.getVersion().toString());
 }
 
-CCNode* geode::createIndexItemLogo(IndexItemHandle item, CCSize const& size) {
-    auto logoPath = ghc::filesystem::absolute(item->getRootPath() / "logo.png");
-    CCNode* spr = CCSprite::create(logoPath.string().c_str());
-    if (!spr) {
-        spr = CCSprite::createWithSpriteFrameName("no-logo.png"_spr);
+// a local build can change the logo without changing the version, so the
+// file's size and modification time are checked as well
+static std::string getLogoFileSource(ghc::filesystem::path const& path) {
+    std::error_code ec;
+    auto size = ghc::filesystem::file_size(path, ec);
+    if (ec) {
+        return "";
+    }
+    auto time = ghc::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return "";
     }
+    return fmt::format("{}:{}", size, time.time_since_epoch().count());
+}
+
+// Thumbnails of versions that are neither installed nor on the index anymore
+// are removed once per session. The index has to be up to date first, or
+// the thumbnails of everything that's only on the index would be removed
+static void pruneLogoThumbnails() {
+    static bool pruned = false;
+    if (pruned || !Index::get()->isUpToDate()) {
+        return;
+    }
+    pruned = true;
+
+    std::unordered_set<std::string> installed;
+    for (auto mod : Loader::get()->getAllMods()) {
+        installed.insert(getLogoKey(INSTALLED_LOGO_PREFIX, mod->getMetadata()));
+    }
+    LogoCache::get()->prune([installed = std::move(installed)](std::string const& key) {
+        if (installed.contains(key)) {
+            return true;
+        }
+        if (!key.starts_with(INDEX_LOGO_PREFIX)) {
+            return false;
+        }
+        auto sep = key.rfind('@');
+        if (sep == std::string::npos) {
+            return false;
+        }
+        auto version = VersionInfo::parse(key.substr(sep + 1));
+        auto id = key.substr(INDEX_LOGO_PREFIX.size(), sep - INDEX_LOGO_PREFIX.size());
+        return version && Index::get()->isKnownItem(id, version.unwrap());
+    });
+}
+
+static CCNode* createLogoSprite(CCTexture2D* thumbnail, CCSize const& size) {
+    CCNode* spr = nullptr;
+    if (thumbnail) {
+        // thumbnails are smaller than the logos they were made from, so 
+        // they have to be allowed to scale up
+        spr = CCSprite::createWithTexture(thumbnail);
+        limitNodeSize(spr, size, FLT_MAX, .01f);
+        return spr;
+    }
+    spr = CCSprite::createWithSpriteFrameName("no-logo.png"_spr);
     if (!spr) {
         spr = CCLabelBMFont::create("N/A", "goldFont.fnt");
     }
-    if (item->isFeatured()) {
-        auto glowSize = size + CCSize(4.f, 4.f);
-
-        auto logoGlow = CCSprite::createWithSpriteFrameName("logo-glow.png"_spr);
-        logoGlow->setScaleX(glowSize.width / logoGlow->getContentSize().width);
-        logoGlow->setScaleY(glowSize.height / logoGlow->getContentSize().height);
-
-        // i dont know why + 1 is needed and its too late for me to figure out why
-        spr->setPosition(
-            logoGlow->getContentSize().width / 2 + 1,
-            logoGlow->getContentSize().height / 2 - 1
-        );
-        // scary mathematics
-        spr->setScaleX(size.width / spr->getContentSize().width / logoGlow->getScaleX());
-        spr->setScaleY(size.height / spr->getContentSize().height / logoGlow->getScaleY());
-        logoGlow->addChild(spr);
-        spr = logoGlow;
-    }
-    else {
-        limitNodeSize(spr, size, 1.f, .01f);
+    limitNodeSize(spr, size, 1.f, .01f);
+    return spr;
+}
+
+CCNode* geode::createModLogo(Mod* mod, CCSize const& size) {
+    auto node = CCNode::create();
+    node->setContentSize(size);
+
+    auto setLogo = [node, size](CCNode* spr) {
+        node->removeAllChildren();
+        spr->setPosition(size/2);
+        spr->setAnchorPoint({.5f, .5f});
+        node->addChild(spr);
+    };
+
+    if (mod == Mod::get()) {
+        CCNode* spr = CCSprite::createWithSpriteFrameName("geode-logo.png"_spr);
+        if (spr) {
+            limitNodeSize(spr, size, 1.f, .01f);
+        }
+        else {
+            spr = createLogoSprite(nullptr, size);
+        }
+        setLogo(spr);
+        return node;
     }
-    spr->setPosition(size/2);
-    spr->setAnchorPoint({.5f, .5f});
 
+    pruneLogoThumbnails();
+
+    // the logo is found the same way CCSprite::create would find it, but 
+    // read on the worker thread
+    auto path = std::string(CCFileUtils::get()->fullPathForFilename(
+        fmt::format("{}/logo.png", mod->getID()).c_str(), false
+    ));
+    auto thumbnail = LogoCache::get()->getThumbnail(
+        getLogoKey(INSTALLED_LOGO_PREFIX, mod->getMetadata()),
+        [path]() {
+            return getLogoFileSource(path);
+        },
+        [path]() {
+            return file::readBinary(path);
+        },
+        [setLogo, size, ref = Ref(node)](CCTexture2D* thumbnail) {
+            setLogo(createLogoSprite(thumbnail, size));
+        }
+    );
+    setLogo(createLogoSprite(thumbnail, size));
+    return node;
+}
+
+CCNode* geode::createIndexItemLogo(IndexItemHandle item, CCSize const& size) {
     auto node = CCNode::create();
-    node->addChild(spr);
     node->setContentSize(size);
+
+    auto setLogo = [node, size, featured = item->isFeatured()](CCTexture2D* thumbnail) {
+        node->removeAllChildren();
+        auto spr = createLogoSprite(thumbnail, size);
+        if (featured) {
+            auto glowSize = size + CCSize(4.f, 4.f);
+
+            auto logoGlow = CCSprite::createWithSpriteFrameName("logo-glow.png"_spr);
+            logoGlow->setScaleX(glowSize.width / logoGlow->getContentSize().width);
+            logoGlow->setScaleY(glowSize.height / logoGlow->getContentSize().height);
+
+            // i dont know why + 1 is needed and its too late for me to figure out why
+            spr->setPosition(
+                logoGlow->getContentSize().width / 2 + 1,
+                logoGlow->getContentSize().height / 2 - 1
+            );
+            // scary mathematics
+            spr->setScaleX(size.width / spr->getContentSize().width / logoGlow->getScaleX());
+            spr->setScaleY(size.height / spr->getContentSize().height / logoGlow->getScaleY());
+            logoGlow->addChild(spr);
+            spr = logoGlow;
+        }
+        spr->setPosition(size/2);
+        spr->setAnchorPoint({.5f, .5f});
+        node->addChild(spr);
+    };
+
+    pruneLogoThumbnails();
+
+    // the index may not be extracted, so read the file through the index
+    // instead of letting cocos find it on disk. A republished version has a
+    // different package hash
+    auto thumbnail = LogoCache::get()->getThumbnail(
+        getLogoKey(INDEX_LOGO_PREFIX, item->getMetadata()),
+        [hash = item->getPackageHash()]() {
+            return hash;
+        },
+        [item]() {
+            return item->readFile("logo.png");
+        },
+        [setLogo, ref = Ref(node)](CCTexture2D* thumbnail) {
+            setLogo(thumbnail);
+        }
+    );
+    setLogo(thumbnail);
     return node;
 }
@@ -0,0 +1,63 @@
+#include "LabelCache.hpp"
+
+LabelCache* LabelCache::get() {
+    static auto inst = new LabelCache();
+    return inst;
+}
+
+size_t LabelCache::KeyHash::operator()(Key const& key) const {
+    auto hash = std::hash<std::string>()(key.text);
+    hash ^= std::hash<std::string>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.width) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<float>()(key.scale) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+CCLabelBMFont* LabelCache::getLabel(
+    std::string const& text, char const* font, float width, float scale, float minScale
+) {
+    Key key { text, font, width, scale, minScale };
+
+    if (auto it = m_index.find(key); it != m_index.end()) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        auto& entry = *it->second;
+
+        // otherwise it's still in use by a cell that's alive, and this one
+        // needs a new label
+        if (!entry.label->getParent()) {
+            CCLabelBMFont* label = entry.label;
+            // undo whatever the previous cell did to it
+            label->setScale(entry.scale);
+            label->setColor({ 255, 255, 255 });
+            label->setOpacity(255);
+            label->setAnchorPoint({ .5f, .5f });
+            label->setPosition({ 0, 0 });
+            label->setVisible(true);
+            return label;
+        }
+    }
+
+    auto label = CCLabelBMFont::create(text.c_str(), font);
+    if (width > 0) {
+        label->limitLabelWidth(width, scale, minScale);
+    }
+    else {
+        label->setScale(scale);
+    }
+
+    if (auto it = m_index.find(key); it != m_index.end()) {
+        // remember the newer label instead, since the old one is busy
+        it->second->label = label;
+        it->second->scale = label->getScale();
+        return label;
+    }
+
+    m_entries.push_front({ key, label, label->getScale() });
+    m_index.insert({ std::move(key), m_entries.begin() });
+
+    while (m_entries.size() > CACHE_LIMIT) {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+    return label;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Geode/utils/cocos.hpp>
+
+#include <list>
+
+using namespace geode::prelude;
+
+/**
+ * Labels for mod list cells. Laying out a CCLabelBMFont creates a sprite for
+ * every glyph, and the same names and descriptions get laid out again every
+ * time the list is rebuilt, so finished labels are kept around and handed
+ * out again once the cell that used them is gone
+ */
+class LabelCache final {
+public:
+    // enough for every label of a few hundred cells
+    static constexpr size_t CACHE_LIMIT = 512;
+
+    static LabelCache* get();
+
+    /**
+     * Get a label showing `text`. If `width` isn't 0 the label is shrunk to
+     * fit it like limitLabelWidth does, otherwise it's just scaled to `scale`.
+     * Only called on the main thread
+     */
+    CCLabelBMFont* getLabel(
+        std::string const& text, char const* font, float width, float scale, float minScale = .1f
+    );
+
+private:
+    struct Key {
+        std::string text;
+        std::string font;
+        float width;
+        float scale;
+        float minScale;
+
+        bool operator==(Key const&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(Key const& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        Ref<CCLabelBMFont> label;
+        // the scale limitLabelWidth picked, since layouts may change it later
+        float scale;
+    };
+
+    // most recently used first
+    std::list<Entry> m_entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+};
@@ -0,0 +1,273 @@
+#include "LogoCache.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/general.hpp>
+
+#include <thread>
+
+// followed by the width, height and source length as 16-bit little endian,
+// the source and then the pixels
+static constexpr uint8_t THUMBNAIL_MAGIC[] = { 'G', 'L', 'T', '2' };
+static constexpr size_t THUMBNAIL_HEADER_SIZE = sizeof(THUMBNAIL_MAGIC) + 6;
+
+LogoCache* LogoCache::get() {
+    static auto inst = new LogoCache();
+    return inst;
+}
+
+CCTexture2D* LogoCache::getThumbnail(
+    std::string const& key, LogoSource source, LoadLogo load, LogoCallback callback
+) {
+    if (auto it = m_index.find(key); it != m_index.end()) {
+        m_thumbnails.splice(m_thumbnails.begin(), m_thumbnails, it->second);
+        return it->second->texture;
+    }
+
+    // someone else already asked for this logo
+    if (auto it = m_waiting.find(key); it != m_waiting.end()) {
+        it->second.push_back(std::move(callback));
+        return nullptr;
+    }
+    m_waiting[key].push_back(std::move(callback));
+
+    std::lock_guard lock(m_jobsMutex);
+    m_jobs.push_back({ key, std::move(source), std::move(load) });
+    this->wakeWorker();
+    return nullptr;
+}
+
+void LogoCache::prune(KeepThumbnail keep) {
+    std::lock_guard lock(m_jobsMutex);
+    m_prune = std::move(keep);
+    this->wakeWorker();
+}
+
+void LogoCache::wakeWorker() {
+    if (!m_workerStarted) {
+        m_workerStarted = true;
+        std::thread([this] { this->work(); }).detach();
+    }
+    m_jobsCV.notify_one();
+}
+
+void LogoCache::work() {
+    thread::setName("Logo Loader");
+    while (true) {
+        Job job;
+        std::optional<KeepThumbnail> prune;
+        {
+            std::unique_lock lock(m_jobsMutex);
+            m_jobsCV.wait(lock, [this] { return !m_jobs.empty() || m_prune; });
+            if (m_prune) {
+                prune = std::move(m_prune);
+                m_prune.reset();
+            }
+            else {
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+        }
+        if (prune) {
+            pruneThumbnails(*prune);
+            continue;
+        }
+
+        std::optional<Thumbnail> thumbnail;
+        if (auto res = loadThumbnail(job)) {
+            thumbnail = std::move(res.unwrap());
+        }
+        else {
+            // plenty of mods just don't have a logo
+            log::debug("Unable to load logo for {}: {}", job.key, res.unwrapErr());
+        }
+
+        Loader::get()->queueInMainThread([this, key = std::move(job.key), thumbnail = std::move(thumbnail)] {
+            this->finish(key, thumbnail);
+        });
+    }
+}
+
+void LogoCache::finish(std::string const& key, std::optional<Thumbnail> const& thumbnail) {
+    CCTexture2D* texture = nullptr;
+    if (thumbnail) {
+        texture = new CCTexture2D();
+        if (texture->initWithData(
+            thumbnail->pixels.data(), kCCTexture2DPixelFormat_RGBA8888,
+            thumbnail->width, thumbnail->height,
+            CCSize(thumbnail->width, thumbnail->height)
+        )) {
+            texture->autorelease();
+        }
+        else {
+            texture->release();
+            texture = nullptr;
+        }
+    }
+    if (!m_index.contains(key)) {
+        m_thumbnails.push_front({ key, texture });
+        m_index.insert({ key, m_thumbnails.begin() });
+        while (m_thumbnails.size() > MEMORY_LIMIT) {
+            m_index.erase(m_thumbnails.back().key);
+            m_thumbnails.pop_back();
+        }
+    }
+
+    auto callbacks = std::move(m_waiting[key]);
+    m_waiting.erase(key);
+    if (texture) {
+        for (auto& callback : callbacks) {
+            callback(texture);
+        }
+    }
+}
+
+ghc::filesystem::path LogoCache::getThumbnailDir() {
+    return dirs::getGeodeDir() / "thumbnails";
+}
+
+void LogoCache::pruneThumbnails(KeepThumbnail const& keep) {
+    auto files = file::readDirectory(getThumbnailDir());
+    if (!files) {
+        return;
+    }
+    size_t removed = 0;
+    for (auto const& path : files.unwrap()) {
+        if (path.extension() != ".thumb" || keep(path.stem().string())) {
+            continue;
+        }
+        std::error_code ec;
+        if (ghc::filesystem::remove(path, ec)) {
+            removed += 1;
+        }
+    }
+    if (removed) {
+        log::debug("Removed {} unused logo thumbnails", removed);
+    }
+}
+
+Result<LogoCache::Thumbnail> LogoCache::loadThumbnail(Job const& job) {
+    auto path = getThumbnailDir() / (job.key + ".thumb");
+    auto source = job.source();
+    if (auto cached = readThumbnail(path, source)) {
+        return cached;
+    }
+
+    GEODE_UNWRAP_INTO(auto data, job.load());
+    GEODE_UNWRAP_INTO(auto thumbnail, createThumbnail(data));
+    if (auto res = writeThumbnail(path, source, thumbnail); !res) {
+        log::warn("Unable to save logo thumbnail for {}: {}", job.key, res.unwrapErr());
+    }
+    return Ok(thumbnail);
+}
+
+Result<LogoCache::Thumbnail> LogoCache::createThumbnail(ByteVector& data) {
+    // decoding doesn't touch any GL state, so this is fine off the main thread
+    auto image = new CCImage();
+    if (!image->initWithImageData(data.data(), data.size())) {
+        image->release();
+        return Err("Unable to decode image");
+    }
+
+    size_t width = image->getWidth();
+    size_t height = image->getHeight();
+    size_t channels = image->hasAlpha() ? 4 : 3;
+    bool premultiplied = image->hasAlpha() && image->isPremultipliedAlpha();
+    auto source = image->getData();
+    if (!width || !height || !source) {
+        image->release();
+        return Err("Image is empty");
+    }
+
+    Thumbnail thumbnail;
+    auto longest = std::max(width, height);
+    thumbnail.width = longest > THUMBNAIL_SIZE ? std::max<size_t>(width * THUMBNAIL_SIZE / longest, 1) : width;
+    thumbnail.height = longest > THUMBNAIL_SIZE ? std::max<size_t>(height * THUMBNAIL_SIZE / longest, 1) : height;
+    thumbnail.pixels.resize(thumbnail.width * thumbnail.height * 4);
+
+    // box filter; the colors are averaged premultiplied so transparent
+    // pixels don't bleed their color into the edges
+    for (size_t y = 0; y < thumbnail.height; y++) {
+        auto y0 = y * height / thumbnail.height;
+        auto y1 = std::max((y + 1) * height / thumbnail.height, y0 + 1);
+        for (size_t x = 0; x < thumbnail.width; x++) {
+            auto x0 = x * width / thumbnail.width;
+            auto x1 = std::max((x + 1) * width / thumbnail.width, x0 + 1);
+
+            uint32_t sum[4] = {};
+            for (auto sy = y0; sy < y1; sy++) {
+                auto pixel = source + (sy * width + x0) * channels;
+                for (auto sx = x0; sx < x1; sx++, pixel += channels) {
+                    uint32_t alpha = channels == 4 ? pixel[3] : 255;
+                    for (size_t c = 0; c < 3; c++) {
+                        sum[c] += premultiplied ? pixel[c] : pixel[c] * alpha / 255;
+                    }
+                    sum[3] += alpha;
+                }
+            }
+
+            auto count = static_cast<uint32_t>((y1 - y0) * (x1 - x0));
+            auto out = thumbnail.pixels.data() + (y * thumbnail.width + x) * 4;
+            auto alpha = sum[3] / count;
+            for (size_t c = 0; c < 3; c++) {
+                auto value = sum[c] / count;
+                out[c] = static_cast<uint8_t>(alpha ? std::min<uint32_t>(value * 255 / alpha, 255) : 0);
+            }
+            out[3] = static_cast<uint8_t>(alpha);
+        }
+    }
+
+    image->release();
+    return Ok(std::move(thumbnail));
+}
+
+Result<LogoCache::Thumbnail> LogoCache::readThumbnail(
+    ghc::filesystem::path const& path, std::string const& source
+) {
+    GEODE_UNWRAP_INTO(auto data, file::readBinary(path));
+    if (
+        data.size() < THUMBNAIL_HEADER_SIZE ||
+        !std::equal(std::begin(THUMBNAIL_MAGIC), std::end(THUMBNAIL_MAGIC), data.begin())
+    ) {
+        return Err("Not a thumbnail");
+    }
+    auto header = data.data() + sizeof(THUMBNAIL_MAGIC);
+    Thumbnail thumbnail;
+    thumbnail.width = header[0] | (header[1] << 8);
+    thumbnail.height = header[2] | (header[3] << 8);
+    size_t sourceSize = header[4] | (header[5] << 8);
+    if (
+        !thumbnail.width || !thumbnail.height ||
+        data.size() != THUMBNAIL_HEADER_SIZE + sourceSize + thumbnail.width * thumbnail.height * 4
+    ) {
+        return Err("Thumbnail is corrupted");
+    }
+    auto savedSource = std::string_view(
+        reinterpret_cast<char const*>(data.data() + THUMBNAIL_HEADER_SIZE), sourceSize
+    );
+    if (savedSource != source) {
+        return Err("Thumbnail is outdated");
+    }
+    thumbnail.pixels.assign(data.begin() + THUMBNAIL_HEADER_SIZE + sourceSize, data.end());
+    return Ok(std::move(thumbnail));
+}
+
+Result<> LogoCache::writeThumbnail(
+    ghc::filesystem::path const& path, std::string const& source, Thumbnail const& thumbnail
+) {
+    if (source.size() > 0xffff) {
+        return Err("Source is too long");
+    }
+    GEODE_UNWRAP(file::createDirectoryAll(path.parent_path()));
+    ByteVector data(std::begin(THUMBNAIL_MAGIC), std::end(THUMBNAIL_MAGIC));
+    data.reserve(THUMBNAIL_HEADER_SIZE + source.size() + thumbnail.pixels.size());
+    data.push_back(static_cast<uint8_t>(thumbnail.width & 0xff));
+    data.push_back(static_cast<uint8_t>(thumbnail.width >> 8));
+    data.push_back(static_cast<uint8_t>(thumbnail.height & 0xff));
+    data.push_back(static_cast<uint8_t>(thumbnail.height >> 8));
+    data.push_back(static_cast<uint8_t>(source.size() & 0xff));
+    data.push_back(static_cast<uint8_t>(source.size() >> 8));
+    data.insert(data.end(), source.begin(), source.end());
+    data.insert(data.end(), thumbnail.pixels.begin(), thumbnail.pixels.end());
+    return file::writeBinary(path, data);
+}
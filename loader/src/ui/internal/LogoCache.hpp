@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Geode/loader/Loader.hpp>
+#include <Geode/utils/cocos.hpp>
+#include <Geode/utils/MiniFunction.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+
+using namespace geode::prelude;
+
+/**
+ * Small versions of mod logos for the mod list. Logos are decoded and shrunk
+ * on a worker thread and saved to disk, so each version of a logo is only
+ * decoded once
+ */
+class LogoCache final {
+public:
+    // thumbnails are shrunk to fit in a square of this many pixels
+    static constexpr size_t THUMBNAIL_SIZE = 128;
+    // thumbnails kept in memory; enough for a few pages of the mod list
+    // without holding on to every logo on the index
+    static constexpr size_t MEMORY_LIMIT = 128;
+
+    using LoadLogo = utils::MiniFunction<Result<ByteVector>()>;
+    using LogoSource = utils::MiniFunction<std::string()>;
+    using LogoCallback = utils::MiniFunction<void(CCTexture2D*)>;
+    using KeepThumbnail = utils::MiniFunction<bool(std::string const&)>;
+
+    static LogoCache* get();
+
+    /**
+     * Get the thumbnail for a logo if it has already been loaded. Otherwise
+     * load it in the background and call `callback` on the main thread once
+     * it's ready. The callback isn't called if the logo couldn't be loaded
+     * @param key Identifies the logo, for example the mod ID and version.
+     * Also names the file the thumbnail is saved in
+     * @param source Identifies the data the logo is read from, for example
+     * the file's size and modification time. A saved thumbnail is only used
+     * if it was made from the same source; called on the worker thread
+     * @param load Reads the full-size logo; called on the worker thread
+     */
+    CCTexture2D* getThumbnail(
+        std::string const& key, LogoSource source, LoadLogo load, LogoCallback callback
+    );
+
+    /**
+     * Delete the saved thumbnails whose key `keep` returns false for. Done in
+     * the background; `keep` is called on the worker thread
+     */
+    void prune(KeepThumbnail keep);
+
+private:
+    struct Thumbnail {
+        size_t width;
+        size_t height;
+        // straight (not premultiplied) RGBA8888
+        ByteVector pixels;
+    };
+
+    struct Job {
+        std::string key;
+        LogoSource source;
+        LoadLogo load;
+    };
+
+    struct Entry {
+        std::string key;
+        // null if loading failed
+        Ref<CCTexture2D> texture;
+    };
+
+    // only accessed on the main thread; most recently used first
+    std::list<Entry> m_thumbnails;
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    std::unordered_map<std::string, std::vector<LogoCallback>> m_waiting;
+
+    std::mutex m_jobsMutex;
+    std::condition_variable m_jobsCV;
+    std::deque<Job> m_jobs;
+    std::optional<KeepThumbnail> m_prune;
+    bool m_workerStarted = false;
+
+    // call with m_jobsMutex locked
+    void wakeWorker();
+    void work();
+    void finish(std::string const& key, std::optional<Thumbnail> const& thumbnail);
+
+    static ghc::filesystem::path getThumbnailDir();
+    static void pruneThumbnails(KeepThumbnail const& keep);
+    static Result<Thumbnail> loadThumbnail(Job const& job);
+    static Result<Thumbnail> createThumbnail(ByteVector& data);
+    static Result<Thumbnail> readThumbnail(ghc::filesystem::path const& path, std::string const& source);
+    static Result<> writeThumbnail(
+        ghc::filesystem::path const& path, std::string const& source, Thumbnail const& thumbnail
+    );
+};
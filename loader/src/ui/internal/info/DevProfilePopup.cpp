@@ -18,7 +18,7 @@ bool DevProfilePopup::setup(std::string const& developer, ModListLayer* list) {
     auto items = CCArray::create();
 
     // installed mods
-    for (auto& mod : Loader::get()->getAllMods()) {
+    for (auto& mod : Loader::get()->getAllModsView()) {
         if (ranges::contains(mod->getDevelopers(), developer)) {
             auto cell = ModCell::create(
                 mod, m_layer, ModListDisplay::Concise, { 358.f, 40.f }
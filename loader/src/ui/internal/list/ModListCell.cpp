@@ -11,6 +11,7 @@
 #include "../info/DevProfilePopup.hpp"
 #include "../info/ModDevsPopup.hpp"
 #include "ProblemsListPopup.hpp"
+#include "../LabelCache.hpp"
 
 template <class T>
 static bool tryOrAlert(Result<T> const& res, char const* title) {
@@ -90,8 +91,7 @@ void ModListCell::setupInfo(
         display == ModListDisplay::Expanded && 
         metadata.getDescription().has_value();
 
-    auto titleLabel = CCLabelBMFont::create(metadata.getName().c_str(), "bigFont.fnt");
-    titleLabel->limitLabelWidth(m_width / 2 - 40.f, .5f, .1f);
+    auto titleLabel = LabelCache::get()->getLabel(metadata.getName(), "bigFont.fnt", m_width / 2 - 40.f, .5f);
     titleLabel->setLayoutOptions(
         AxisLayoutOptions::create()
             ->setScalePriority(1)
@@ -103,9 +103,9 @@ void ModListCell::setupInfo(
     }
     m_labelMenu->addChild(titleLabel);
 
-    auto versionLabel = CCLabelBMFont::create(
-        metadata.getVersion().toString(false).c_str(),
-        "bigFont.fnt"
+    auto versionLabel = LabelCache::get()->getLabel(
+        metadata.getVersion().toString(false),
+        "bigFont.fnt", 0.f, 1.f
     );
     versionLabel->setColor({ 0, 255, 0 });
     if (inactive) {
@@ -142,8 +142,7 @@ void ModListCell::setupInfo(
     }
 
     auto creatorStr = "by " + ModMetadata::formatDeveloperDisplayString(metadata.getDevelopers());
-    auto creatorLabel = CCLabelBMFont::create(creatorStr.c_str(), "goldFont.fnt");
-    creatorLabel->setScale(.43f);
+    auto creatorLabel = LabelCache::get()->getLabel(creatorStr, "goldFont.fnt", 0.f, .43f);
     if (inactive) {
         creatorLabel->setColor({ 163, 163, 163 });
     }
@@ -169,10 +168,11 @@ void ModListCell::setupInfo(
         node->setPosition(descBG->getContentSize() / 2);
         descBG->addChild(node);
 
-        m_description = CCLabelBMFont::create(metadata.getDescription().value().c_str(), "chatFont.fnt");
+        m_description = LabelCache::get()->getLabel(
+            metadata.getDescription().value(), "chatFont.fnt", node->getContentSize().width - 5.f, .5f
+        );
         m_description->setAnchorPoint({ .5f, .5f });
         m_description->setPosition(node->getContentSize() / 2);
-        m_description->limitLabelWidth(node->getContentSize().width - 5.f, 0.5f, .1f);
         if (inactive) {
             m_description->setColor({ 163, 163, 163 });
         }
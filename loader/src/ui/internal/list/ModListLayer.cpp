@@ -37,9 +37,13 @@ static std::optional<int> fuzzyMatch(std::string const& kw, std::string const& s
     return std::nullopt;
 }
 
+// `keywordsMatched` is set if the keywords were found in some field, even if 
+// the match was too weak to be listed. Longer keywords can only match what 
+// shorter ones did, since all of their characters have to be found in order
 static std::optional<int> queryMatchKeywords(
     ModListQuery const& query,
-    ModMetadata const& metadata
+    ModMetadata const& metadata,
+    bool* keywordsMatched = nullptr
 ) {
     double weighted = 0;
 
@@ -60,6 +64,9 @@ static std::optional<int> queryMatchKeywords(
         if (!someMatched) {
             return std::nullopt;
         }
+        if (keywordsMatched) {
+            *keywordsMatched = true;
+        }
     }
     else {
         if (metadata.getID() == "geode.loader") {
@@ -83,14 +90,18 @@ static std::optional<int> queryMatchKeywords(
     return static_cast<int>(weighted);
 }
 
-static std::optional<int> queryMatch(ModListQuery const& query, Mod* mod) {
+static std::optional<int> queryMatch(
+    ModListQuery const& query, Mod* mod, bool* keywordsMatched = nullptr
+) {
     // Only checking keywords makes sense for mods since their 
     // platform always matches, they are always visible and they don't 
     // currently list their tags
-    return queryMatchKeywords(query, mod->getMetadata());
+    return queryMatchKeywords(query, mod->getMetadata(), keywordsMatched);
 }
 
-static std::optional<int> queryMatch(ModListQuery const& query, IndexItemHandle item) {
+static std::optional<int> queryMatch(
+    ModListQuery const& query, IndexItemHandle item, bool* keywordsMatched = nullptr
+) {
     // if no force visibility was provided and item is already installed, don't show it
     if (!query.forceVisibility && Loader::get()->isModInstalled(item->getMetadata().getID())) {
         return std::nullopt;
@@ -118,7 +129,7 @@ static std::optional<int> queryMatch(ModListQuery const& query, IndexItemHandle
         return std::nullopt;
     }
     // otherwise match keywords
-    if (auto match = queryMatchKeywords(query, item->getMetadata())) {
+    if (auto match = queryMatchKeywords(query, item->getMetadata(), keywordsMatched)) {
         auto weighted = match.value();
         // add extra weight on tag matches
         if (query.keywords) {
@@ -147,84 +158,129 @@ static std::optional<int> queryMatch(ModListQuery const& query, InvalidGeodeFile
     return 0;
 }
 
-CCArray* ModListLayer::createModCells(ModListType type, ModListQuery const& query) {
-    auto mods = CCArray::create();
+std::vector<ModListSource> ModListLayer::collectSources(ModListType type) const {
+    std::vector<ModListSource> sources;
     switch (type) {
         default:
         case ModListType::Installed: {
-            // problems first
-            if (!Loader::get()->getProblems().empty()) {
-                mods->addObject(ProblemsCell::create(this, m_display, this->getCellSize()));
-            }
-
-            // sort the mods by match score
-            std::multimap<int, ModListCell*> sorted;
-
-            // then other mods
-
             // newly installed
             for (auto const& item : Index::get()->getItems()) {
                 if (!item->isInstalled() ||
                     Loader::get()->isModInstalled(item->getMetadata().getID()) ||
                     Loader::get()->isModLoaded(item->getMetadata().getID()))
                     continue;
-                // match the same as other installed mods
-                if (auto match = queryMatchKeywords(query, item->getMetadata())) {
-                    auto cell = IndexItemCell::create(item, this, m_display, this->getCellSize());
-                    sorted.insert({ match.value(), cell });
-                }
+                sources.push_back(item);
             }
 
             // loaded
-            for (auto const& mod : Loader::get()->getAllMods()) {
-                if (auto match = queryMatch(query, mod)) {
-                    auto cell = ModCell::create(mod, this, m_display, this->getCellSize());
-                    sorted.insert({ match.value(), cell });
-                }
-            }
-
-            // add the mods sorted
-            for (auto& [score, cell] : ranges::reverse(sorted)) {
-                mods->addObject(cell);
+            for (auto const& mod : Loader::get()->getAllModsView()) {
+                sources.push_back(mod);
             }
         } break;
 
         case ModListType::Download: {
-            // sort the mods by match score 
-            std::multimap<int, IndexItemHandle> sorted;
-
-            auto index = Index::get();
-            for (auto const& item : index->getLatestItems()) {
-                if (auto match = queryMatch(query, item)) {
-                    sorted.insert({ match.value(), item });
-                }
+            for (auto const& item : Index::get()->getLatestItems()) {
+                sources.push_back(item);
             }
+        } break;
 
-            // add the mods sorted
-            for (auto& [score, item] : ranges::reverse(sorted)) {
-                mods->addObject(IndexItemCell::create(
-                    item, this, m_display, this->getCellSize()
-                ));
+        case ModListType::Featured: {
+            for (auto const& item : Index::get()->getFeaturedItems()) {
+                sources.push_back(item);
             }
         } break;
+    }
+    return sources;
+}
 
-        case ModListType::Featured: {
-            // sort the mods by match score 
-            std::multimap<int, IndexItemHandle> sorted;
+CCNode* ModListLayer::getModCell(ModListSource const& source) {
+    auto key = std::visit(makeVisitor {
+        [](Mod* mod) -> void const* {
+            return mod;
+        },
+        [](IndexItemHandle const& item) -> void const* {
+            return item.get();
+        }
+    }, source);
 
-            for (auto const& item : Index::get()->getFeaturedItems()) {
-                if (auto match = queryMatch(query, item)) {
-                    sorted.insert({ match.value(), item });
+    if (auto it = m_cellCache.find(key); it != m_cellCache.end()) {
+        // the cell is still in the previous list
+        if (it->second->getParent()) {
+            it->second->removeFromParentAndCleanup(false);
+        }
+        return it->second;
+    }
+
+    auto cell = std::visit(makeVisitor {
+        [&](Mod* mod) -> CCNode* {
+            return ModCell::create(mod, this, m_display, this->getCellSize());
+        },
+        [&](IndexItemHandle const& item) -> CCNode* {
+            return IndexItemCell::create(item, this, m_display, this->getCellSize());
+        }
+    }, source);
+    m_cellCache.insert({ key, cell });
+    return cell;
+}
+
+CCArray* ModListLayer::createModCells(ModListType type, ModListQuery const& query) {
+    auto mods = CCArray::create();
+
+    // problems first
+    if (type == ModListType::Installed && !Loader::get()->getProblems().empty()) {
+        mods->addObject(ProblemsCell::create(this, m_display, this->getCellSize()));
+    }
+
+    // if the keywords only grew, only what the previous ones matched needs 
+    // to be checked again
+    std::vector<ModListSource> sources;
+    if (
+        m_searchCandidates && query.keywords &&
+        query.keywords.value().starts_with(m_searchKeywords)
+    ) {
+        sources = std::move(m_searchCandidates.value());
+    }
+    else {
+        sources = this->collectSources(type);
+    }
+
+    // sort the mods by match score
+    std::multimap<int, ModListSource> sorted;
+    std::vector<ModListSource> candidates;
+
+    for (auto& source : sources) {
+        bool keywordsMatched = false;
+        auto match = std::visit(makeVisitor {
+            [&](Mod* mod) {
+                return queryMatch(query, mod, &keywordsMatched);
+            },
+            [&](IndexItemHandle const& item) {
+                // newly installed items match the same as other installed mods
+                if (type == ModListType::Installed) {
+                    return queryMatchKeywords(query, item->getMetadata(), &keywordsMatched);
                 }
+                return queryMatch(query, item, &keywordsMatched);
             }
+        }, source);
+        if (match) {
+            sorted.insert({ match.value(), source });
+        }
+        if (keywordsMatched) {
+            candidates.push_back(std::move(source));
+        }
+    }
 
-            // add the mods sorted
-            for (auto& [score, item] : ranges::reverse(sorted)) {
-                mods->addObject(IndexItemCell::create(
-                    item, this, m_display, this->getCellSize()
-                ));
-            }
-        } break;
+    if (query.keywords) {
+        m_searchKeywords = query.keywords.value();
+        m_searchCandidates = std::move(candidates);
+    }
+    else {
+        m_searchCandidates = std::nullopt;
+    }
+
+    // add the mods sorted
+    for (auto& [score, source] : ranges::reverse(sorted)) {
+        mods->addObject(this->getModCell(source));
     }
     return mods;
 }
@@ -450,6 +506,14 @@ void ModListLayer::createSearchControl() {
 }
 
 void ModListLayer::reloadList(bool keepScroll, std::optional<ModListQuery> const& query) {
+    // anything but typing in the search box may change which mods can be 
+    // listed and how their cells look
+    m_searchCandidates = std::nullopt;
+    m_cellCache.clear();
+    this->refreshList(keepScroll, query);
+}
+
+void ModListLayer::refreshList(bool keepScroll, std::optional<ModListQuery> const& query) {
     auto winSize = CCDirector::sharedDirector()->getWinSize();
 
     if (query) {
@@ -708,7 +772,14 @@ void ModListLayer::onTab(CCObject* pSender) {
 }
 
 void ModListLayer::textChanged(CCTextInputNode* input) {
-    this->reloadList(false);
+    // wait until the user stops typing for a moment so the list isn't 
+    // rebuilt on every keystroke
+    this->unschedule(schedule_selector(ModListLayer::onSearchTimer));
+    this->scheduleOnce(schedule_selector(ModListLayer::onSearchTimer), .2f);
+}
+
+void ModListLayer::onSearchTimer(float) {
+    this->refreshList(false);
 }
 
 // Constructors etc.
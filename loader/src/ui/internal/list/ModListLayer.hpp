@@ -41,6 +41,11 @@ struct ModListQuery {
     std::unordered_set<std::string> tags;
 };
 
+/**
+ * What a mod list cell was created from
+ */
+using ModListSource = std::variant<Mod*, IndexItemHandle>;
+
 class ModListLayer : public CCLayer, public TextInputDelegate {
 protected:
     GJListLayer* m_list = nullptr;
@@ -64,6 +69,13 @@ protected:
     ModListQuery m_query;
     ModListDisplay m_display = ModListDisplay::Concise;
     EventListener<IndexUpdateFilter> m_indexListener;
+    // everything the last keywords matched, so the search can be narrowed 
+    // down instead of starting over while the query only grows
+    std::optional<std::vector<ModListSource>> m_searchCandidates;
+    std::string m_searchKeywords;
+    // cells are reused between searches and only created again on a full 
+    // reload
+    std::unordered_map<void const*, Ref<CCNode>> m_cellCache;
 
     virtual ~ModListLayer();
 
@@ -78,6 +90,7 @@ protected:
     void onTab(CCObject*);
     void onFilters(CCObject*);
     void textChanged(CCTextInputNode*) override;
+    void onSearchTimer(float);
     void createSearchControl();
     void onIndexUpdate(IndexUpdateEvent* event);
 
@@ -85,6 +98,9 @@ protected:
     void keyBackClicked() override;
 
     CCArray* createModCells(ModListType type, ModListQuery const& query);
+    std::vector<ModListSource> collectSources(ModListType type) const;
+    CCNode* getModCell(ModListSource const& source);
+    void refreshList(bool keepScroll, std::optional<ModListQuery> const& query = std::nullopt);
     CCSize getCellSize() const;
     CCSize getListSize() const;
 
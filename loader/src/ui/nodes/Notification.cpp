@@ -1,13 +1,17 @@
 #include <Geode/binding/LoadingCircle.hpp>
 #include <Geode/loader/Mod.hpp>
 #include <Geode/ui/Notification.hpp>
+#include <cstring>
 
 using namespace geode::prelude;
 
 constexpr auto NOTIFICATION_FADEIN = .3f;
 constexpr auto NOTIFICATION_FADEOUT = 1.f;
+// how many notifications can wait behind the one being shown
+constexpr size_t NOTIFICATION_QUEUE_LIMIT = 8;
 
 Ref<CCArray> Notification::s_queue = nullptr;
+static size_t s_burstThreshold = 0;
 
 bool Notification::init(std::string const& text, CCSprite* icon, float time) {
     if (!CCNodeRGBA::init()) return false;
@@ -61,6 +65,9 @@ void Notification::showNextNotification() {
     SceneManager::get()->forget(this);
     // remove self from front of queue
     s_queue->removeFirstObject();
+    if (s_burstThreshold && s_queue->count() > s_burstThreshold) {
+        collapseQueue();
+    }
     if (auto obj = s_queue->firstObject()) {
         as<Notification*>(obj)->show();
     }
@@ -154,6 +161,74 @@ void Notification::animateOut() {
     m_bg->runAction(CCFadeTo::create(NOTIFICATION_FADEOUT, 0));
 }
 
+void Notification::setBurstThreshold(size_t threshold) {
+    s_burstThreshold = threshold;
+}
+
+bool Notification::isSameAs(Notification* other) {
+    if (m_time != other->m_time || std::strcmp(m_label->getString(), other->m_label->getString())) {
+        return false;
+    }
+    if (!m_icon || !other->m_icon) {
+        return !m_icon && !other->m_icon;
+    }
+    return m_icon->getTexture() == other->m_icon->getTexture() &&
+        m_icon->getTextureRect().equals(other->m_icon->getTextureRect());
+}
+
+Notification* Notification::findPending(Notification* notification) {
+    // notifications without a time are kept around and updated by whoever
+    // created them, so they're never merged with anything
+    if (!notification->m_time) {
+        return nullptr;
+    }
+    for (auto other : CCArrayExt<Notification*>(s_queue.data())) {
+        if (!other->m_showing && other->isSameAs(notification)) {
+            return other;
+        }
+    }
+    return nullptr;
+}
+
+void Notification::dropOverflow() {
+    auto front = static_cast<Notification*>(s_queue->firstObject());
+    size_t pending = s_queue->count() - (front && front->m_showing ? 1 : 0);
+    if (pending < NOTIFICATION_QUEUE_LIMIT) {
+        return;
+    }
+    // notifications without a time are probably being updated by someone, 
+    // so only drop ones that would go away on their own anyway
+    for (unsigned int i = 0; i < s_queue->count(); i++) {
+        auto notif = static_cast<Notification*>(s_queue->objectAtIndex(i));
+        if (!notif->m_showing && notif->m_time) {
+            s_queue->removeObjectAtIndex(i);
+            return;
+        }
+    }
+}
+
+void Notification::collapseQueue() {
+    Notification* summary = nullptr;
+    size_t merged = 0;
+    for (unsigned int i = 0; i < s_queue->count();) {
+        auto notif = static_cast<Notification*>(s_queue->objectAtIndex(i));
+        if (notif->m_showing || !notif->m_time) {
+            i++;
+        }
+        else if (!summary) {
+            summary = notif;
+            i++;
+        }
+        else {
+            s_queue->removeObjectAtIndex(i);
+            merged++;
+        }
+    }
+    if (summary && merged) {
+        summary->setString(fmt::format("{} (+{} more)", summary->m_label->getString(), merged));
+    }
+}
+
 void Notification::waitAndHide() {
     this->setTime(NOTIFICATION_DEFAULT_TIME);
 }
@@ -164,6 +239,10 @@ void Notification::show() {
     }
     if (!m_showing) {
         if (!s_queue->containsObject(this)) {
+            if (findPending(this)) {
+                return;
+            }
+            dropOverflow();
             s_queue->addObject(this);
         }
         if (s_queue->firstObject() != this) {
@@ -5,6 +5,21 @@
 
 using namespace geode::prelude;
 
+// draw runs every frame but the target is rarely scrolled or resized, and
+// resizing a scale9 sprite rebuilds all of its quads, so nothing is set
+// unless it actually changed
+static void setContentSizeIfChanged(CCNode* node, CCSize const& size) {
+    if (!node->getContentSize().equals(size)) {
+        node->setContentSize(size);
+    }
+}
+
+static void setPositionIfChanged(CCNode* node, CCPoint const& pos) {
+    if (!node->getPosition().equals(pos)) {
+        node->setPosition(pos);
+    }
+}
+
 bool Scrollbar::ccTouchBegan(CCTouch* touch, CCEvent* event) {
     // hitbox
     auto const size = this->getContentSize();
@@ -69,16 +84,16 @@ void Scrollbar::draw() {
     auto targetHeight = m_target->getScaledContentSize().height;
 
     if (m_trackIsRotated) {
-        m_track->setContentSize({ targetHeight / m_track->getScale(),
-                                  m_width / m_track->getScale() });
+        setContentSizeIfChanged(m_track, { targetHeight / m_track->getScale(),
+                                           m_width / m_track->getScale() });
     }
     else {
-        m_track->setContentSize({ m_width / m_track->getScale(),
-                                  targetHeight / m_track->getScale() });
+        setContentSizeIfChanged(m_track, { m_width / m_track->getScale(),
+                                           targetHeight / m_track->getScale() });
     }
-    m_track->setPosition(m_obContentSize / 2);
+    setPositionIfChanged(m_track, m_obContentSize / 2);
 
-    this->setContentSize({ m_width, targetHeight });
+    setContentSizeIfChanged(this, { m_width, targetHeight });
 
     auto h = contentHeight - targetHeight + m_target->m_scrollLimitTop;
     auto p = targetHeight / contentHeight;
@@ -99,7 +114,9 @@ void Scrollbar::draw() {
             o = 125;
         }
     }
-    m_thumb->setColor({ o, o, o });
+    if (m_thumb->getColor() != ccc3(o, o, o)) {
+        m_thumb->setColor({ o, o, o });
+    }
 
     auto y = m_target->m_contentLayer->getPositionY();
 
@@ -134,9 +151,9 @@ void Scrollbar::draw() {
         thumbPosY -= fHeightBottom();
     }
 
-    m_thumb->setPosition(m_obContentSize / 2 + ccp(0.f, thumbPosY));
+    setPositionIfChanged(m_thumb, m_obContentSize / 2 + ccp(0.f, thumbPosY));
     if (m_resizeThumb) {
-        m_thumb->setContentSize({ m_width, thumbHeight });
+        setContentSizeIfChanged(m_thumb, { m_width, thumbHeight });
     }
 }
 
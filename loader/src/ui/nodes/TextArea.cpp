@@ -2,6 +2,233 @@
 
 using namespace geode::prelude;
 
+namespace {
+    // Glyph metrics from a .fnt file, so lines can be measured without
+    // laying out a label after every character
+    class FontMetrics final {
+        struct Glyph {
+            float advance;
+            // how far the glyph's image sticks out past its advance, which
+            // CCLabelBMFont adds to the width if it's the last character
+            float overhang;
+        };
+
+        CCBMFontConfiguration* m_config = nullptr;
+        std::unordered_map<unsigned int, Glyph> m_glyphs;
+        std::unordered_map<unsigned int, float> m_kerning;
+
+        void load(CCBMFontConfiguration* config) {
+            m_config = config;
+            m_glyphs.clear();
+            m_kerning.clear();
+            if (!config) return;
+
+            auto scale = CC_CONTENT_SCALE_FACTOR();
+            for (auto def = config->m_pFontDefDictionary; def; def = static_cast<tCCFontDefHashElement*>(def->hh.next)) {
+                auto& fontDef = def->fontDef;
+                m_glyphs[def->key] = {
+                    fontDef.xAdvance / scale,
+                    std::max(fontDef.rect.size.width - fontDef.xAdvance, 0.f) / scale,
+                };
+            }
+            for (auto kerning = config->m_pKerningDictionary; kerning; kerning = static_cast<tCCKerningHashElement*>(kerning->hh.next)) {
+                m_kerning[static_cast<unsigned int>(kerning->key)] = kerning->amount / scale;
+            }
+        }
+
+    public:
+        static FontMetrics const& get(std::string const& font) {
+            static std::unordered_map<std::string, FontMetrics> metrics;
+            // the config is cached by cocos, and gets replaced if the
+            // texture quality changes
+            auto config = FNTConfigLoadFile(font.c_str());
+            auto& entry = metrics[font];
+            if (entry.m_config != config) {
+                entry.load(config);
+            }
+            return entry;
+        }
+
+        float advance(unsigned int previous, unsigned int c) const {
+            float advance = 0;
+            if (auto it = m_glyphs.find(c); it != m_glyphs.end()) {
+                advance = it->second.advance;
+            }
+            if (previous && !m_kerning.empty()) {
+                if (auto it = m_kerning.find((previous << 16) | (c & 0xffff)); it != m_kerning.end()) {
+                    advance += it->second;
+                }
+            }
+            return advance;
+        }
+
+        float overhang(unsigned int c) const {
+            if (auto it = m_glyphs.find(c); it != m_glyphs.end()) {
+                return it->second.overhang;
+            }
+            return 0;
+        }
+    };
+
+    // Keeps track of how wide a line's label would be as characters are
+    // added to it
+    class LineMeasure final {
+        FontMetrics const& m_metrics;
+        float m_advance = 0;
+        unsigned int m_last = 0;
+        // for UTF-8 sequences that are still being added
+        unsigned int m_pending = 0;
+        int m_remaining = 0;
+
+    public:
+        LineMeasure(FontMetrics const& metrics) : m_metrics(metrics) {}
+
+        void push(const char c) {
+            auto byte = static_cast<unsigned char>(c);
+            if (m_remaining && (byte & 0xc0) == 0x80) {
+                m_pending = (m_pending << 6) | (byte & 0x3f);
+                if (--m_remaining) return;
+            }
+            else if (byte >= 0xc0) {
+                m_remaining = byte >= 0xf0 ? 3 : (byte >= 0xe0 ? 2 : 1);
+                m_pending = byte & (0x3f >> m_remaining);
+                return;
+            }
+            else {
+                m_remaining = 0;
+                m_pending = byte;
+            }
+            m_advance += m_metrics.advance(m_last, m_pending);
+            m_last = m_pending;
+        }
+
+        void reset(std::string_view text) {
+            m_advance = 0;
+            m_last = 0;
+            m_pending = 0;
+            m_remaining = 0;
+            for (const char c : text) {
+                this->push(c);
+            }
+        }
+
+        float width() const {
+            return m_last ? m_advance + m_metrics.overhang(m_last) : 0;
+        }
+    };
+
+    // What the lines are wrapped by, taken from a SimpleTextArea
+    struct WrapSettings final {
+        std::string const& text;
+        std::string const& font;
+        float scale;
+        bool artificialWidth;
+        float width;
+        size_t maxLines;
+    };
+}
+
+// The lines are only turned into labels once they're final, so wrapping
+// works on strings
+
+static std::vector<std::string> wrapLines(WrapSettings const& settings, const std::function<std::string(std::string& line, const char c)>& overflowHandling) {
+    LineMeasure measure(FontMetrics::get(settings.font));
+    std::vector<std::string> lines = { "" };
+
+    for (const char c : settings.text) {
+        if (settings.maxLines && lines.size() > settings.maxLines) {
+            lines.pop_back();
+
+            std::string& last = lines.back();
+            last = last.substr(0, last.size() - 3).append("...");
+
+            break;
+        } else if (c == '\n') {
+            lines.emplace_back();
+            measure.reset("");
+        } else if (settings.artificialWidth && measure.width() * settings.scale >= settings.width) {
+            std::string next = overflowHandling(lines.back(), c);
+            lines.push_back(std::move(next));
+            measure.reset(lines.back());
+        } else {
+            lines.back() += c;
+            measure.push(c);
+        }
+    }
+
+    return lines;
+}
+
+static std::vector<std::string> splitLines(std::string const& text, const size_t maxLines) {
+    std::stringstream stream(text);
+    std::string part;
+    std::vector<std::string> lines;
+
+    while (std::getline(stream, part)) {
+        if (maxLines && lines.size() >= maxLines) {
+            std::string& last = lines.at(maxLines - 1);
+            last = last.substr(0, last.size() - 3).append("...");
+
+            break;
+        } else {
+            lines.push_back(part);
+        }
+    }
+
+    return lines;
+}
+
+static std::string wordWrapOverflow(std::string& line, const char c) {
+    static std::string delimiters(" `~!@#$%^&*()-_=+[{}];:'\",<.>/?\\|");
+
+    if (delimiters.find(c) == std::string_view::npos) {
+        const size_t position = line.find_last_of(delimiters) + 1;
+        std::string next = line.substr(position) + c;
+
+        line.erase(position);
+
+        return next;
+    } else {
+        return std::string(c != ' ', c);
+    }
+}
+
+static std::string cutoffWrapOverflow(std::string& line, const char c) {
+    if (line.empty()) {
+        return std::string(c != ' ', c);
+    }
+
+    const char back = line.back();
+    const bool lastIsSpace = back == ' ';
+    std::string next = std::string(!lastIsSpace, back).append(std::string(c != ' ', c));
+
+    if (!lastIsSpace) {
+        line.pop_back();
+        if (!line.empty() && line.back() != ' ') {
+            line += '-';
+        }
+    }
+
+    return next;
+}
+
+// createLabel and calculateOffset are protected, so they're passed in by the
+// members calling this
+template <class CreateLabel, class CalculateOffset>
+static std::vector<CCLabelBMFont*> createLines(std::vector<std::string> const& lines, SimpleTextArea* area, CreateLabel createLabel, CalculateOffset calculateOffset) {
+    std::vector<CCLabelBMFont*> labels;
+    float top = 0;
+
+    for (const std::string& text : lines) {
+        CCLabelBMFont* label = (area->*createLabel)(text, top);
+
+        top -= (area->*calculateOffset)(label);
+        labels.push_back(label);
+    }
+
+    return labels;
+}
+
 SimpleTextArea* SimpleTextArea::create(const std::string& text, const std::string& font, const float scale) {
     return SimpleTextArea::create(font, text, scale, CCDirector::sharedDirector()->getWinSize().width / 2, false);
 }
@@ -101,10 +328,9 @@ size_t SimpleTextArea::getMaxLines() {
 
 void SimpleTextArea::setWidth(const float width) {
     m_artificialWidth = true;
+    // the lines are wrapped to the container's width
+    m_container->setContentSize({ width, m_container->getContentSize().height });
     this->updateContainer();
-
-    this->setContentSize({ width, this->getContentSize().height });
-    m_container->setContentSize(this->getContentSize());
 }
 
 float SimpleTextArea::getWidth() {
@@ -157,86 +383,41 @@ float SimpleTextArea::calculateOffset(CCLabelBMFont* label) {
 }
 
 void SimpleTextArea::charIteration(const std::function<CCLabelBMFont*(CCLabelBMFont* line, const char c, const float top)>& overflowHandling) {
-    float top = 0;
-    CCLabelBMFont* line = this->createLabel("", top);
-    m_lines = { line };
-
-    for (const char c : m_text) {
-        if (m_maxLines && m_lines.size() > m_maxLines) {
-            CCLabelBMFont* last = m_lines.at(m_maxLines - 1);
-            const std::string text = last->getString();
+    // the callback gets a label of the line that overflowed, and the label it
+    // returns is the start of the next line
+    const auto lines = wrapLines(
+        { m_text, m_font, m_scale, m_artificialWidth, this->getWidth(), m_maxLines },
+        [&](std::string& line, const char c) {
+            CCLabelBMFont* label = this->createLabel(line, 0);
+            CCLabelBMFont* next = overflowHandling(label, c, 0);
 
-            m_lines.pop_back();
-            last->setString(text.substr(0, text.size() - 3).append("...").c_str());
+            line = label->getString();
 
-            break;
-        } else if (c == '\n') {
-            m_lines.push_back(line = this->createLabel("", top -= this->calculateOffset(line)));
-        } else if (m_artificialWidth && line->getContentSize().width * m_scale >= this->getWidth()) {
-            m_lines.push_back(line = overflowHandling(line, c, top -= this->calculateOffset(line)));
-        } else {
-            line->setString((std::string(line->getString()) + c).c_str());
+            return std::string(next->getString());
         }
-    }
+    );
+    m_lines = createLines(lines, this, &SimpleTextArea::createLabel, &SimpleTextArea::calculateOffset);
 }
 
 void SimpleTextArea::updateLinesNoWrap() {
-    std::stringstream stream(m_text);
-    std::string part;
-    float top = 0;
-
-    while (std::getline(stream, part)) {
-        if (m_maxLines && m_lines.size() >= m_maxLines) {
-            CCLabelBMFont* last = m_lines.at(m_maxLines - 1);
-            const std::string text = last->getString();
-
-            last->setString(text.substr(0, text.size() - 3).append("...").c_str());
-
-            break;
-        } else {
-            CCLabelBMFont* line = this->createLabel(part, 0);
-
-            top -= this->calculateOffset(line);
-
-            m_lines.push_back(line);
-        }
-    }
+    const auto lines = splitLines(m_text, m_maxLines);
+    m_lines = createLines(lines, this, &SimpleTextArea::createLabel, &SimpleTextArea::calculateOffset);
 }
 
 void SimpleTextArea::updateLinesWordWrap() {
-    this->charIteration([this](CCLabelBMFont* line, const char c, const float top) {
-        static std::string delimiters(" `~!@#$%^&*()-_=+[{}];:'\",<.>/?\\|");
-
-        if (delimiters.find(c) == std::string_view::npos) {
-            const std::string text = line->getString();
-            const size_t position = text.find_last_of(delimiters) + 1;
-
-            line->setString(text.substr(0, position).c_str());
-
-            return this->createLabel(text.substr(position) + c, top);
-        } else {
-            return this->createLabel(std::string(c, c != ' '), top);
-        }
-    });
+    const auto lines = wrapLines(
+        { m_text, m_font, m_scale, m_artificialWidth, this->getWidth(), m_maxLines },
+        &wordWrapOverflow
+    );
+    m_lines = createLines(lines, this, &SimpleTextArea::createLabel, &SimpleTextArea::calculateOffset);
 }
 
 void SimpleTextArea::updateLinesCutoffWrap() {
-    this->charIteration([this](CCLabelBMFont* line, const char c, const float top) {
-        const std::string text = line->getString();
-        const char back = text.back();
-        const bool lastIsSpace = back == ' ';
-        CCLabelBMFont* newLine = this->createLabel(std::string(!lastIsSpace, back).append(std::string(c != ' ', c)), top);
-
-        if (!lastIsSpace) {
-            if (text[text.size() - 2] == ' ') {
-                line->setString(text.substr(0, text.size() - 1).c_str());
-            } else {
-                line->setString((text.substr(0, text.size() - 1) + '-').c_str());
-            }
-        }
-
-        return newLine;
-    });
+    const auto lines = wrapLines(
+        { m_text, m_font, m_scale, m_artificialWidth, this->getWidth(), m_maxLines },
+        &cutoffWrapOverflow
+    );
+    m_lines = createLines(lines, this, &SimpleTextArea::createLabel, &SimpleTextArea::calculateOffset);
 }
 
 void SimpleTextArea::updateContainer() {
@@ -377,15 +377,18 @@ std::vector<TextRenderer::Label> TextRenderer::renderStringEx(
     if (!createLabel()) return {};
 
     bool firstLine = true;
-    for (auto line : utils::string::split(str, "\n")) {
+    std::string word;
+    for (auto line : utils::string::splitView(str, "\n")) {
         if (!firstLine && !nextLine()) {
             return {};
         }
         firstLine = false;
-        for (auto word : utils::string::split(line, " ")) {
+        for (auto part : utils::string::splitView(line, " ")) {
             // add extra space in front of word if not on
             // new line
-            if (!newLine) word = " " + word;
+            word.clear();
+            if (!newLine) word = " ";
+            word += part;
             newLine = false;
 
             // update capitalization
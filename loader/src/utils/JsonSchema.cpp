@@ -0,0 +1,117 @@
+#include "JsonSchema.hpp"
+
+#include <Geode/utils/JsonValidation.hpp>
+#include <algorithm>
+#include <optional>
+
+using namespace geode::prelude;
+
+// TODO: gross hack :3 (ctrl+f this comment to find the other part)
+extern thread_local bool s_jsonCheckerShouldCheckUnknownKeys;
+
+// how a value was reached, kept on the stack while validating and only
+// turned into a string for error messages
+struct JsonSchema::Path final {
+    Path const* parent = nullptr;
+    // the name of the document, only set on the root
+    std::string_view root;
+    std::string_view key;
+    std::optional<size_t> index;
+
+    // same format as JsonMaybeSomething::hierarchy
+    std::string toString() const {
+        if (!parent) {
+            return std::string(root);
+        }
+        auto step = index ? std::to_string(*index) : std::string(key);
+        if (!parent->parent) {
+            return step;
+        }
+        return parent->toString() + "." + step;
+    }
+};
+
+JsonSchema JsonSchema::any() {
+    return JsonSchema();
+}
+
+JsonSchema JsonSchema::of(matjson::Type type) {
+    JsonSchema schema;
+    schema.m_type = type;
+    return schema;
+}
+
+JsonSchema JsonSchema::array(JsonSchema elements) {
+    auto schema = JsonSchema::of(matjson::Type::Array);
+    schema.m_elements = std::make_shared<JsonSchema const>(std::move(elements));
+    return schema;
+}
+
+JsonSchema JsonSchema::object(std::vector<Field> fields, bool warnUnknownKeys) {
+    auto schema = JsonSchema::of(matjson::Type::Object);
+    std::sort(fields.begin(), fields.end(), [](auto const& a, auto const& b) {
+        return a.key < b.key;
+    });
+    schema.m_requiredCount = std::count_if(fields.begin(), fields.end(), [](auto const& field) {
+        return field.required;
+    });
+    schema.m_fields = std::move(fields);
+    schema.m_warnUnknownKeys = warnUnknownKeys;
+    return schema;
+}
+
+Result<> JsonSchema::validate(matjson::Value const& json, std::string_view hierarchy) const {
+    return this->validate(json, Path { .root = hierarchy });
+}
+
+Result<> JsonSchema::validate(matjson::Value const& json, Path const& path) const {
+    if (!jsonConvertibleTo(json.type(), m_type)) {
+        return Err(
+            path.toString() + ": Invalid type \"" + jsonValueTypeToString(json.type()) +
+            "\", expected \"" + jsonValueTypeToString(m_type) + "\""
+        );
+    }
+
+    if (m_elements && json.is_array()) {
+        size_t i = 0;
+        for (auto& value : json.as_array()) {
+            GEODE_UNWRAP(m_elements->validate(value, Path { .parent = &path, .index = i++ }));
+        }
+    }
+
+    if (m_type == matjson::Type::Object && json.is_object()) {
+        size_t foundRequired = 0;
+        for (auto& [key, value] : json.as_object()) {
+            auto field = std::lower_bound(
+                m_fields.begin(), m_fields.end(), key,
+                [](Field const& field, std::string_view key) {
+                    return field.key < key;
+                }
+            );
+            if (field == m_fields.end() || field->key != key) {
+                if (m_warnUnknownKeys && s_jsonCheckerShouldCheckUnknownKeys) {
+                    log::warn("{} contains unknown key \"{}\"", path.toString(), key);
+                }
+                continue;
+            }
+            if (field->required) {
+                foundRequired += 1;
+            }
+            // JsonMaybeObject::has treats null the same as a missing key
+            else if (value.is_null()) {
+                continue;
+            }
+            GEODE_UNWRAP(field->schema.validate(value, Path { .parent = &path, .key = key }));
+        }
+
+        if (foundRequired < m_requiredCount) {
+            for (auto& field : m_fields) {
+                if (field.required && !json.contains(field.key)) {
+                    return Err(path.toString() + " is missing required key \"" + field.key + "\"");
+                }
+            }
+        }
+    }
+
+    return Ok();
+}
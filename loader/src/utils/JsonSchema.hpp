@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Geode/utils/Result.hpp>
+#include <matjson.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace geode {
+    /**
+     * The expected shape of a kind of JSON document, built once and reused
+     * for every document of that kind. Checks types, required keys and
+     * unknown keys in a single pass without allocating, and reports errors
+     * in the same format as JsonChecker
+     */
+    class JsonSchema final {
+    public:
+        struct Field;
+
+    private:
+        // Null accepts any type
+        matjson::Type m_type = matjson::Type::Null;
+        // sorted by key
+        std::vector<Field> m_fields;
+        size_t m_requiredCount = 0;
+        bool m_warnUnknownKeys = false;
+        std::shared_ptr<JsonSchema const> m_elements;
+
+        struct Path;
+
+        Result<> validate(matjson::Value const& json, Path const& path) const;
+
+    public:
+        JsonSchema() = default;
+
+        static JsonSchema any();
+        static JsonSchema of(matjson::Type type);
+        static JsonSchema array(JsonSchema elements);
+        /**
+         * An object with the given fields
+         * @param warnUnknownKeys Whether to log keys not in fields, like
+         * JsonMaybeObject::checkUnknownKeys
+         */
+        static JsonSchema object(std::vector<Field> fields, bool warnUnknownKeys = true);
+
+        /**
+         * Check a document against this schema
+         * @param hierarchy The name of the document in error messages
+         * @returns The first error found, if any
+         */
+        Result<> validate(matjson::Value const& json, std::string_view hierarchy) const;
+    };
+
+    struct JsonSchema::Field final {
+        std::string key;
+        JsonSchema schema;
+        bool required = false;
+    };
+}
@@ -1,7 +1,55 @@
 #include <Geode/utils/JsonValidation.hpp>
+#include <optional>
+#include <string_view>
 
 using namespace geode::prelude;
 
+// TODO: gross hack :3 (ctrl+f this comment to find the other part)
+extern thread_local bool s_jsonCheckerShouldCheckUnknownKeys;
+thread_local bool s_jsonCheckerShouldCheckUnknownKeys = true;
+
+namespace {
+    // single pass over the object instead of contains() followed by
+    // operator[], which would look the key up twice
+    matjson::Value* findKey(matjson::Value& json, std::string_view key) {
+        if (!json.is_object()) return nullptr;
+        for (auto& [k, v] : json.as_object()) {
+            if (k == key) {
+                return &v;
+            }
+        }
+        return nullptr;
+    }
+
+    // appends the keys and indices leading from `from` to `target` to path
+    bool appendPath(matjson::Value const& from, matjson::Value const* target, std::string& path) {
+        auto step = [&](std::string_view name, matjson::Value const& child) {
+            auto size = path.size();
+            if (size) {
+                path += '.';
+            }
+            path += name;
+            if (&child == target || appendPath(child, target, path)) {
+                return true;
+            }
+            path.resize(size);
+            return false;
+        };
+        if (from.is_object()) {
+            for (auto& [key, value] : from.as_object()) {
+                if (step(key, value)) return true;
+            }
+        }
+        else if (from.is_array()) {
+            size_t i = 0;
+            for (auto& value : from.as_array()) {
+                if (step(std::to_string(i++), value)) return true;
+            }
+        }
+        return false;
+    }
+}
+
 
 matjson::Value& JsonMaybeSomething::json() {
     return m_json;
@@ -15,6 +63,18 @@ JsonMaybeSomething::JsonMaybeSomething(
     m_json(json), m_hierarchy(hierarchy), m_hasValue(hasValue) {}
 
 
+std::string JsonMaybeSomething::hierarchy() const {
+    // values don't keep their path around, since it's only needed for error
+    // messages. the checked document outlives every value made from it, so
+    // the path is found by looking for this value in it instead
+    std::string path;
+    if (&m_json == &m_checker.m_json || !appendPath(m_checker.m_json, &m_json, path)) {
+        return m_hierarchy;
+    }
+    return path;
+}
+
+
 bool JsonMaybeSomething::isError() const {
     return m_checker.isError() || !m_hasValue;
 }
@@ -204,16 +264,14 @@ JsonMaybeValue JsonMaybeValue::at(size_t i) {
     auto& json = self().m_json.as_array();
     if (json.size() <= i) {
         this->setError(
-            self().m_hierarchy + ": has " + std::to_string(json.size()) +
+            self().hierarchy() + ": has " + std::to_string(json.size()) +
             "items "
             ", expected to have at least " +
             std::to_string(i + 1)
         );
         return *this;
     }
-    return JsonMaybeValue(
-        self().m_checker, json.at(i), self().m_hierarchy + "." + std::to_string(i), self().m_hasValue
-    );
+    return JsonMaybeValue(self().m_checker, json.at(i), "", self().m_hasValue);
 }
 
 
@@ -223,11 +281,9 @@ typename JsonMaybeValue::template Iterator<JsonMaybeValue> JsonMaybeValue::itera
     if (this->isError()) return iter;
 
     auto& json = self().m_json.as_array();
-    size_t i = 0;
+    iter.m_values.reserve(json.size());
     for (auto& obj : json) {
-        iter.m_values.emplace_back(
-            self().m_checker, obj, self().m_hierarchy + "." + std::to_string(i++), self().m_hasValue
-        );
+        iter.m_values.emplace_back(self().m_checker, obj, "", self().m_hasValue);
     }
     return iter;
 }
@@ -239,10 +295,7 @@ typename JsonMaybeValue::template Iterator<std::pair<std::string, JsonMaybeValue
     if (this->isError()) return iter;
 
     for (auto& [k, v] : self().m_json.as_object()) {
-        iter.m_values.emplace_back(
-            k,
-            JsonMaybeValue(self().m_checker, v, self().m_hierarchy + "." + k, self().m_hasValue)
-        );
+        iter.m_values.emplace_back(k, JsonMaybeValue(self().m_checker, v, "", self().m_hasValue));
     }
 
     return iter;
@@ -276,35 +329,44 @@ JsonMaybeValue JsonMaybeObject::emptyValue() {
 
 
 JsonMaybeValue JsonMaybeObject::has(std::string const& key) {
-    this->addKnownKey(key);
+    auto found = findKey(self().m_json, key);
+    // keys that aren't there can't be reported as unknown, so only the
+    // present ones need remembering
+    if (found && s_jsonCheckerShouldCheckUnknownKeys) {
+        this->addKnownKey(key);
+    }
     if (this->isError()) return emptyValue();
-    if (!self().m_json.contains(key) || self().m_json[key].is_null()) {
+    if (!found || found->is_null()) {
         return emptyValue();
     }
-    return JsonMaybeValue(self().m_checker, self().m_json[key], key, true);
+    return JsonMaybeValue(self().m_checker, *found, "", true);
 }
 
 
 JsonMaybeValue JsonMaybeObject::needs(std::string const& key) {
-    this->addKnownKey(key);
+    auto found = findKey(self().m_json, key);
+    if (found && s_jsonCheckerShouldCheckUnknownKeys) {
+        this->addKnownKey(key);
+    }
     if (this->isError()) return emptyValue();
-    if (!self().m_json.contains(key)) {
-        this->setError(self().m_hierarchy + " is missing required key \"" + key + "\"");
+    if (!found) {
+        this->setError(self().hierarchy() + " is missing required key \"" + key + "\"");
         return emptyValue();
     }
-    return JsonMaybeValue(self().m_checker, self().m_json[key], key, true);
+    return JsonMaybeValue(self().m_checker, *found, "", true);
 }
 
 
-// TODO: gross hack :3 (ctrl+f this comment to find the other part)
-extern bool s_jsonCheckerShouldCheckUnknownKeys;
-bool s_jsonCheckerShouldCheckUnknownKeys = true;
 void JsonMaybeObject::checkUnknownKeys() {
     if (!s_jsonCheckerShouldCheckUnknownKeys)
         return;
+    std::optional<std::string> hierarchy;
     for (auto& [key, _] : self().m_json.as_object()) {
         if (!m_knownKeys.count(key)) {
-            log::warn("{} contains unknown key \"{}\"", self().m_hierarchy, key);
+            if (!hierarchy) {
+                hierarchy = self().hierarchy();
+            }
+            log::warn("{} contains unknown key \"{}\"", *hierarchy, key);
         }
     }
 }
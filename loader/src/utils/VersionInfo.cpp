@@ -6,30 +6,45 @@
 #include <Geode/utils/general.hpp>
 #include <matjson.hpp>
 
+#include <cctype>
+#include <charconv>
+
 using namespace geode::prelude;
 
-// VersionTag
+// Parsing works on a view that's advanced past whatever has been read
 
-Result<VersionTag> VersionTag::parse(std::stringstream& str) {
-    std::string iden;
-    while ('a' <= str.peek() && str.peek() <= 'z') {
-        iden += str.get();
+static bool parseNumber(std::string_view& str, size_t& out) {
+    // like stream extraction, allow whitespace before the number, which
+    // mod.json dependencies like ">= 1.2.0" rely on
+    while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front()))) {
+        str.remove_prefix(1);
     }
-    if (str.fail()) {
-        return Err("Unable to parse tag");
+    auto res = std::from_chars(str.data(), str.data() + str.size(), out);
+    if (res.ec != std::errc()) {
+        return false;
+    }
+    str.remove_prefix(res.ptr - str.data());
+    return true;
+}
+
+static Result<VersionTag> parseTag(std::string_view& str) {
+    size_t length = 0;
+    while (length < str.size() && 'a' <= str[length] && str[length] <= 'z') {
+        length += 1;
     }
+    auto iden = str.substr(0, length);
+    str.remove_prefix(length);
+
     VersionTag tag = VersionTag::Alpha;
-    switch (hash(iden.c_str())) {
-        case hash("alpha"): tag = VersionTag::Alpha; break;
-        case hash("beta"): tag = VersionTag::Beta; break;
-        case hash("prerelease"): case hash("pr"): tag = VersionTag::Prerelease; break;
-        default: return Err("Invalid tag \"" + iden + "\"");
-    }
-    if (str.peek() == '.') {
-        str.get();
+    if (iden == "alpha") tag = VersionTag::Alpha;
+    else if (iden == "beta") tag = VersionTag::Beta;
+    else if (iden == "prerelease" || iden == "pr") tag = VersionTag::Prerelease;
+    else return Err("Invalid tag \"" + std::string(iden) + "\"");
+
+    if (!str.empty() && str.front() == '.') {
+        str.remove_prefix(1);
         size_t num;
-        str >> num;
-        if (str.fail()) {
+        if (!parseNumber(str, num)) {
             return Err("Unable to parse tag number");
         }
         tag.number = num;
@@ -37,6 +52,20 @@ Result<VersionTag> VersionTag::parse(std::stringstream& str) {
     return Ok(tag);
 }
 
+// VersionTag
+
+Result<VersionTag> VersionTag::parse(std::stringstream& str) {
+    auto pos = str.tellg();
+    if (pos < 0) {
+        return Err("Unable to parse tag");
+    }
+    auto rest = str.str().substr(static_cast<size_t>(pos));
+    std::string_view view = rest;
+    auto res = parseTag(view);
+    str.seekg(rest.size() - view.size(), std::ios::cur);
+    return res;
+}
+
 std::string VersionTag::toSuffixString() const {
     std::string res = "";
     switch (value) {
@@ -65,54 +94,55 @@ std::string VersionTag::toString() const {
 
 // VersionInfo
 
-Result<VersionInfo> VersionInfo::parse(std::string const& string) {
-    std::stringstream str (string);
-
+static Result<VersionInfo> parseVersion(std::string_view str) {
     // allow leading v
-    if (str.peek() == 'v') {
-        str.get();
+    if (!str.empty() && str.front() == 'v') {
+        str.remove_prefix(1);
     }
 
     size_t major;
-    str >> major;
-    if (str.fail()) {
+    if (!parseNumber(str, major)) {
         return Err("Unable to parse major");
     }
 
-    if (str.get() != '.') {
+    if (str.empty() || str.front() != '.') {
         return Err("Minor version missing");
     }
+    str.remove_prefix(1);
 
     size_t minor;
-    str >> minor;
-    if (str.fail()) {
+    if (!parseNumber(str, minor)) {
         return Err("Unable to parse minor");
     }
 
-    if (str.get() != '.') {
+    if (str.empty() || str.front() != '.') {
         return Err("Patch version missing");
     }
+    str.remove_prefix(1);
 
     size_t patch;
-    str >> patch;
-    if (str.fail()) {
+    if (!parseNumber(str, patch)) {
         return Err("Unable to parse patch");
     }
 
     // tag
     std::optional<VersionTag> tag;
-    if (str.peek() == '-') {
-        str.get();
-        GEODE_UNWRAP_INTO(tag, VersionTag::parse(str));
+    if (!str.empty() && str.front() == '-') {
+        str.remove_prefix(1);
+        GEODE_UNWRAP_INTO(tag, parseTag(str));
     }
 
-    if (!str.eof()) {
-        return Err("Expected end of version, found '" + std::string(1, str.get()) + "'");
+    if (!str.empty()) {
+        return Err("Expected end of version, found '" + std::string(1, str.front()) + "'");
     }
 
     return Ok(VersionInfo(major, minor, patch, tag));
 }
 
+Result<VersionInfo> VersionInfo::parse(std::string const& string) {
+    return parseVersion(string);
+}
+
 std::string VersionInfo::toString(bool includeTag) const {
     if (includeTag && m_tag) {
         return fmt::format(
@@ -132,7 +162,7 @@ std::string geode::format_as(VersionInfo const& version) {
 
 Result<ComparableVersionInfo> ComparableVersionInfo::parse(std::string const& rawStr) {
     VersionCompare compare;
-    auto string = rawStr;
+    std::string_view string = rawStr;
 
     if (string == "*") {
         return Ok(ComparableVersionInfo({0, 0, 0}, VersionCompare::Any));
@@ -140,29 +170,29 @@ Result<ComparableVersionInfo> ComparableVersionInfo::parse(std::string const& ra
 
     if (string.starts_with("<=")) {
         compare = VersionCompare::LessEq;
-        string.erase(0, 2);
+        string.remove_prefix(2);
     }
     else if (string.starts_with(">=")) {
         compare = VersionCompare::MoreEq;
-        string.erase(0, 2);
+        string.remove_prefix(2);
     }
     else if (string.starts_with("=")) {
         compare = VersionCompare::Exact;
-        string.erase(0, 1);
+        string.remove_prefix(1);
     }
     else if (string.starts_with("<")) {
         compare = VersionCompare::Less;
-        string.erase(0, 1);
+        string.remove_prefix(1);
     }
     else if (string.starts_with(">")) {
         compare = VersionCompare::More;
-        string.erase(0, 1);
+        string.remove_prefix(1);
     }
     else {
         compare = VersionCompare::MoreEq;
     }
 
-    GEODE_UNWRAP_INTO(auto version, VersionInfo::parse(string));
+    GEODE_UNWRAP_INTO(auto version, parseVersion(string));
     return Ok(ComparableVersionInfo(version, compare));
 }
 
@@ -0,0 +1,216 @@
+#include "WebEngine.hpp"
+
+#include <Geode/utils/general.hpp>
+#include <algorithm>
+#include <chrono>
+#include <future>
+
+using namespace geode::prelude;
+using namespace geode::utils::web;
+
+// new transfers are only picked up between polls, so don't wait for
+// socket activity for longer than this
+static constexpr long MAX_POLL_MS = 50;
+static constexpr size_t MAX_IDLE_HANDLES = 8;
+static constexpr long MAX_CACHED_CONNECTIONS = 16;
+static constexpr auto PERFORM_POLL_INTERVAL = std::chrono::milliseconds(50);
+
+WebEngine::WebEngine() {
+    m_multi = curl_multi_init();
+    curl_multi_setopt(m_multi, CURLMOPT_MAXCONNECTS, MAX_CACHED_CONNECTIONS);
+
+    // handles are only attached to the share while they run on the engine
+    // thread, so it doesn't need any locking callbacks
+    m_share = curl_share_init();
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+    auto thread = std::thread(&WebEngine::run, this);
+    m_threadID = thread.get_id();
+    thread.detach();
+}
+
+WebEngine* WebEngine::get() {
+    static auto inst = new WebEngine();
+    return inst;
+}
+
+void WebEngine::setMaxConcurrentTransfers(size_t max) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_maxConcurrent = std::max<size_t>(max, 1);
+    }
+    m_cv.notify_one();
+}
+
+CURL* WebEngine::createHandle() {
+    CURL* handle = nullptr;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_idleHandles.empty()) {
+            handle = m_idleHandles.back();
+            m_idleHandles.pop_back();
+        }
+    }
+    if (handle) {
+        curl_easy_reset(handle);
+    }
+    else {
+        handle = curl_easy_init();
+        if (!handle) return nullptr;
+    }
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    return handle;
+}
+
+void WebEngine::releaseHandle(CURL* handle) {
+    if (!handle) return;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_idleHandles.size() < MAX_IDLE_HANDLES) {
+            m_idleHandles.push_back(handle);
+            return;
+        }
+    }
+    curl_easy_cleanup(handle);
+}
+
+void WebEngine::enqueue(CURL* handle, int priority, DoneCallback done) {
+    this->enqueue(handle, priority, false, std::move(done));
+}
+
+void WebEngine::enqueue(CURL* handle, int priority, bool blocking, DoneCallback done) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_pending.push_back({ handle, priority, blocking, m_nextOrder++, std::move(done) });
+    }
+    m_cv.notify_one();
+}
+
+CURLcode WebEngine::perform(CURL* handle, int priority, utils::MiniFunction<void()> poll) {
+    // waiting for the engine from the engine thread would never finish
+    if (std::this_thread::get_id() == m_threadID) {
+        curl_easy_setopt(handle, CURLOPT_SHARE, m_share);
+        auto res = curl_easy_perform(handle);
+        curl_easy_setopt(handle, CURLOPT_SHARE, nullptr);
+        if (poll) poll();
+        return res;
+    }
+    std::promise<CURLcode> promise;
+    auto future = promise.get_future();
+    this->enqueue(handle, priority, true, [&promise](CURLcode res) {
+        promise.set_value(res);
+    });
+    if (poll) {
+        while (future.wait_for(PERFORM_POLL_INTERVAL) != std::future_status::ready) {
+            poll();
+        }
+        poll();
+    }
+    return future.get();
+}
+
+void WebEngine::start(PendingTransfer transfer) {
+    curl_easy_setopt(transfer.handle, CURLOPT_SHARE, m_share);
+    m_active.insert({ transfer.handle, std::move(transfer.done) });
+    curl_multi_add_handle(m_multi, transfer.handle);
+}
+
+void WebEngine::startPending() {
+    std::lock_guard lock(m_mutex);
+
+    // someone is blocked waiting on these (possibly the main thread), so
+    // they don't wait behind downloads for a free slot
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->blocking) {
+            this->start(std::move(*it));
+            it = m_pending.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    while (!m_pending.empty() && m_active.size() < m_maxConcurrent) {
+        auto next = std::min_element(
+            m_pending.begin(), m_pending.end(),
+            [](PendingTransfer const& a, PendingTransfer const& b) {
+                if (a.priority != b.priority) {
+                    return a.priority > b.priority;
+                }
+                return a.order < b.order;
+            }
+        );
+        auto transfer = std::move(*next);
+        m_pending.erase(next);
+        this->start(std::move(transfer));
+    }
+}
+
+void WebEngine::finishCompleted() {
+    CURLMsg* msg;
+    int left = 0;
+    while ((msg = curl_multi_info_read(m_multi, &left))) {
+        if (msg->msg != CURLMSG_DONE) continue;
+        // msg is invalidated by removing the handle
+        auto handle = msg->easy_handle;
+        auto result = msg->data.result;
+        curl_multi_remove_handle(m_multi, handle);
+        curl_easy_setopt(handle, CURLOPT_SHARE, nullptr);
+
+        auto it = m_active.find(handle);
+        if (it == m_active.end()) continue;
+        auto done = std::move(it->second);
+        m_active.erase(it);
+        done(result);
+    }
+}
+
+void WebEngine::wait() {
+    if (m_active.empty()) {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this]() {
+            return !m_pending.empty();
+        });
+        return;
+    }
+
+    long timeout = -1;
+    curl_multi_timeout(m_multi, &timeout);
+    if (timeout < 0 || timeout > MAX_POLL_MS) {
+        timeout = MAX_POLL_MS;
+    }
+    if (timeout == 0) return;
+
+    fd_set readFds;
+    fd_set writeFds;
+    fd_set errorFds;
+    FD_ZERO(&readFds);
+    FD_ZERO(&writeFds);
+    FD_ZERO(&errorFds);
+    int maxFd = -1;
+    curl_multi_fdset(m_multi, &readFds, &writeFds, &errorFds, &maxFd);
+
+    // curl has no sockets to wait on yet (for example while resolving)
+    if (maxFd == -1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+        return;
+    }
+    timeval tv;
+    tv.tv_sec = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
+    select(maxFd + 1, &readFds, &writeFds, &errorFds, &tv);
+}
+
+void WebEngine::run() {
+    thread::setName("Web Engine");
+
+    while (true) {
+        this->startPending();
+        int running = 0;
+        curl_multi_perform(m_multi, &running);
+        this->finishCompleted();
+        this->wait();
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Geode/cocos/platform/IncludeCurl.h>
+#include <Geode/utils/MiniFunction.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace geode::utils::web {
+    /**
+     * A single thread that drives every web request through one curl multi
+     * handle, so connections, DNS lookups and TLS sessions are reused
+     * between requests and only a limited amount of transfers run at once
+     */
+    class WebEngine final {
+    public:
+        using DoneCallback = utils::MiniFunction<void(CURLcode)>;
+
+    private:
+        struct PendingTransfer {
+            CURL* handle;
+            int priority;
+            // someone is waiting on it in perform
+            bool blocking;
+            size_t order;
+            DoneCallback done;
+        };
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::vector<PendingTransfer> m_pending;
+        size_t m_nextOrder = 0;
+        size_t m_maxConcurrent = 6;
+        std::vector<CURL*> m_idleHandles;
+
+        // only touched on the engine thread
+        std::unordered_map<CURL*, DoneCallback> m_active;
+
+        CURLM* m_multi = nullptr;
+        CURLSH* m_share = nullptr;
+        std::thread::id m_threadID;
+
+        WebEngine();
+
+        void run();
+        void enqueue(CURL* handle, int priority, bool blocking, DoneCallback done);
+        void start(PendingTransfer transfer);
+        void startPending();
+        void finishCompleted();
+        void wait();
+
+    public:
+        static WebEngine* get();
+
+        /**
+         * Set the maximum amount of transfers that run at the same time.
+         * Transfers over the limit wait in the queue by priority
+         */
+        void setMaxConcurrentTransfers(size_t max);
+
+        /**
+         * Get a handle that shares the engine's caches. Handles are pooled,
+         * so give it back with `releaseHandle` once the transfer is done
+         */
+        CURL* createHandle();
+        void releaseHandle(CURL* handle);
+
+        /**
+         * Queue a transfer. Transfers with a higher priority are started
+         * first, otherwise they are started in the order they were queued
+         * @param done Called on the engine thread when the transfer is
+         * done; it should not block
+         */
+        void enqueue(CURL* handle, int priority, DoneCallback done);
+
+        /**
+         * Queue a transfer and block until it's done. Blocking transfers are
+         * started right away, even if the limit of concurrent transfers has
+         * been reached
+         * @param poll Called on the calling thread every so often while it
+         * waits, and once more after the transfer is done. Lets the caller
+         * run its own callbacks (like progress) without holding up the
+         * engine thread
+         */
+        CURLcode perform(CURL* handle, int priority = 0, utils::MiniFunction<void()> poll = nullptr);
+    };
+}
@@ -158,6 +158,9 @@ struct ZipEntry {
     bool isDirectory;
     int64_t compressedSize;
     int64_t uncompressedSize;
+    // position of the entry in the central directory, so it can be jumped
+    // to directly instead of scanning for its name
+    int64_t centralDirPos;
 };
 
 class Zip::Impl final {
@@ -241,6 +244,7 @@ private:
                 .isDirectory = mz_zip_entry_is_dir(m_handle) == MZ_OK,
                 .compressedSize = info->compressed_size,
                 .uncompressedSize = info->uncompressed_size,
+                .centralDirPos = mz_zip_get_entry(m_handle),
             } });
 
             err = mz_zip_goto_next_entry(m_handle);
@@ -379,16 +383,8 @@ public:
         }
 
         GEODE_UNWRAP(
-            mzTry(mz_zip_goto_first_entry(m_handle))
-            .expect("Unable to navigate to first entry (code {error})")
-        );
-
-        GEODE_UNWRAP(
-            mzTry(mz_zip_locate_entry(
-                m_handle,
-                reinterpret_cast<const char*>(name.u8string().c_str()),
-                1
-            )).expect("Unable to navigate to entry (code {error})")
+            mzTry(mz_zip_goto_entry(m_handle, entry.centralDirPos))
+            .expect("Unable to navigate to entry (code {error})")
         );
 
         GEODE_UNWRAP(
@@ -1,8 +1,124 @@
 #include <Geode/utils/string.hpp>
 #include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define GEODE_STRING_SSE2
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define GEODE_STRING_NEON
+#endif
 
 using namespace geode::prelude;
 
+// Search
+
+size_t utils::string::find(std::string_view str, char c, size_t from) {
+    if (from >= str.size()) return std::string_view::npos;
+    // memchr is vectorized by every libc we ship on
+    auto found = static_cast<char const*>(std::memchr(str.data() + from, c, str.size() - from));
+    return found ? static_cast<size_t>(found - str.data()) : std::string_view::npos;
+}
+
+size_t utils::string::find(std::string_view str, std::string_view subs, size_t from) {
+    if (subs.size() <= 1) {
+        if (subs.empty()) return from <= str.size() ? from : std::string_view::npos;
+        return utils::string::find(str, subs[0], from);
+    }
+    if (from >= str.size() || str.size() - from < subs.size()) {
+        return std::string_view::npos;
+    }
+    auto data = str.data();
+    auto size = str.size();
+    auto last = subs.size() - 1;
+    size_t i = from;
+#ifdef GEODE_STRING_SSE2
+    // compare the first and last character of the substring against 16
+    // positions at once, and only check the positions where both match
+    auto first = _mm_set1_epi8(subs[0]);
+    auto end = _mm_set1_epi8(subs[last]);
+    for (; i + last + 16 <= size; i += 16) {
+        auto blockFirst = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+        auto blockLast = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i + last));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, end)
+        )));
+        while (mask) {
+            auto bit = std::countr_zero(mask);
+            if (std::memcmp(data + i + bit + 1, subs.data() + 1, last - 1) == 0) {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+#else
+    // jump between occurrences of the first character
+    while (i + last < size) {
+        auto found = static_cast<char const*>(std::memchr(data + i, subs[0], size - last - i));
+        if (!found) return std::string_view::npos;
+        i = found - data;
+        if (data[i + last] == subs[last] && std::memcmp(data + i + 1, subs.data() + 1, last - 1) == 0) {
+            return i;
+        }
+        i += 1;
+    }
+#endif
+    return str.find(subs, i);
+}
+
+static size_t countChar(std::string_view str, char c) {
+    auto data = reinterpret_cast<uint8_t const*>(str.data());
+    auto size = str.size();
+    size_t res = 0;
+    size_t i = 0;
+#if defined(GEODE_STRING_SSE2)
+    auto needle = _mm_set1_epi8(c);
+    for (; i + 16 <= size; i += 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+        res += std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))));
+    }
+#elif defined(GEODE_STRING_NEON)
+    auto needle = vdupq_n_u8(static_cast<uint8_t>(c));
+    while (i + 16 <= size) {
+        // matches are 0xff, so subtracting them counts up by one. The
+        // per-lane counters are flushed before they can overflow
+        auto counts = vdupq_n_u8(0);
+        auto blocks = std::min<size_t>((size - i) / 16, 255);
+        for (size_t b = 0; b < blocks; b++, i += 16) {
+            counts = vsubq_u8(counts, vceqq_u8(vld1q_u8(data + i), needle));
+        }
+        auto sums = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(counts)));
+        res += vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1);
+    }
+#endif
+    for (; i < size; i++) {
+        if (data[i] == static_cast<uint8_t>(c)) res++;
+    }
+    return res;
+}
+
+static bool isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+std::string_view utils::string::trimLeftView(std::string_view str) {
+    size_t start = 0;
+    while (start < str.size() && isSpace(str[start])) start++;
+    return str.substr(start);
+}
+
+std::string_view utils::string::trimRightView(std::string_view str) {
+    size_t end = str.size();
+    while (end > 0 && isSpace(str[end - 1])) end--;
+    return str.substr(0, end);
+}
+
+std::string_view utils::string::trimView(std::string_view str) {
+    return utils::string::trimLeftView(utils::string::trimRightView(str));
+}
+
 #ifdef GEODE_IS_WINDOWS
 
     #include <Windows.h>
@@ -26,7 +142,7 @@ std::wstring utils::string::utf8ToWide(std::string const& str) {
 #endif
 
 bool utils::string::startsWith(std::string const& str, std::string const& prefix) {
-    return str.rfind(prefix, 0) == 0;
+    return std::string_view(str).starts_with(prefix);
 }
 
 bool utils::string::startsWith(std::wstring const& str, std::wstring const& prefix) {
@@ -34,8 +150,7 @@ bool utils::string::startsWith(std::wstring const& str, std::wstring const& pref
 }
 
 bool utils::string::endsWith(std::string const& str, std::string const& suffix) {
-    if (suffix.size() > str.size()) return false;
-    return std::equal(suffix.rbegin(), suffix.rend(), str.rbegin());
+    return std::string_view(str).ends_with(suffix);
 }
 
 bool utils::string::endsWith(std::wstring const& str, std::wstring const& suffix) {
@@ -43,10 +158,12 @@ bool utils::string::endsWith(std::wstring const& str, std::wstring const& suffix
     return std::equal(suffix.rbegin(), suffix.rend(), str.rbegin());
 }
 
+// ASCII only, so UTF-8 sequences are left alone instead of being passed
+// to std::tolower as negative chars
 std::string& utils::string::toLowerIP(std::string& str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](auto c) {
-        return std::tolower(c);
-    });
+    for (auto& c : str) {
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    }
     return str;
 }
 
@@ -68,9 +185,9 @@ std::wstring utils::string::toLower(std::wstring const& str) {
 }
 
 std::string& utils::string::toUpperIP(std::string& str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](auto c) {
-        return std::toupper(c);
-    });
+    for (auto& c : str) {
+        if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    }
     return str;
 }
 
@@ -92,11 +209,21 @@ std::wstring utils::string::toUpper(std::wstring const& str) {
 }
 
 std::string& utils::string::replaceIP(std::string& str, std::string const& orig, std::string const& repl) {
-    std::string::size_type n = 0;
-    while ((n = str.find(orig, n)) != std::string::npos) {
-        str.replace(n, orig.size(), repl);
-        n += repl.size();
-    }
+    if (orig.empty()) return str;
+    auto n = utils::string::find(str, orig);
+    if (n == std::string::npos) return str;
+    // build the result in one pass instead of shifting the tail of the
+    // string for every occurrence
+    std::string res;
+    res.reserve(str.size());
+    size_t prev = 0;
+    do {
+        res.append(str, prev, n - prev);
+        res += repl;
+        prev = n + orig.size();
+    } while ((n = utils::string::find(str, orig, prev)) != std::string::npos);
+    res.append(str, prev);
+    str = std::move(res);
     return str;
 }
 
@@ -127,14 +254,9 @@ std::wstring utils::string::replace(
 
 std::vector<std::string> utils::string::split(std::string const& str, std::string const& split) {
     std::vector<std::string> res;
-    if (str.empty()) return res;
-    auto s = str;
-    size_t pos;
-    while ((pos = s.find(split)) != std::string::npos) {
-        res.push_back(s.substr(0, pos));
-        s.erase(0, pos + split.length());
+    for (auto part : utils::string::splitView(str, split)) {
+        res.emplace_back(part);
     }
-    res.push_back(s);
     return res;
 }
 
@@ -157,14 +279,14 @@ std::string utils::string::join(std::vector<std::string> const& strs, std::strin
         return res;
     if (strs.size() == 1)
         return strs[0];
-    // idk if less allocations but an extra loop is faster but
-    size_t size = 0;
+    size_t size = separator.size() * (strs.size() - 1);
     for (auto const& str : strs)
-        size += str.size() + separator.size();
+        size += str.size();
     res.reserve(size);
-    for (auto const& str : strs)
-        res += str + separator;
-    res.erase(res.size() - separator.size());
+    for (size_t i = 0; i < strs.size(); i++) {
+        if (i != 0) res += separator;
+        res += strs[i];
+    }
     return res;
 }
 
@@ -202,7 +324,7 @@ std::vector<wchar_t> utils::string::split(std::wstring const& str) {
 }
 
 bool utils::string::contains(std::string const& str, std::string const& subs) {
-    return str.find(subs) != std::string::npos;
+    return utils::string::find(str, subs) != std::string::npos;
 }
 
 bool utils::string::contains(std::wstring const& str, std::wstring const& subs) {
@@ -210,7 +332,7 @@ bool utils::string::contains(std::wstring const& str, std::wstring const& subs)
 }
 
 bool utils::string::contains(std::string const& str, std::string::value_type c) {
-    return str.find(c) != std::string::npos;
+    return utils::string::find(str, c) != std::string::npos;
 }
 
 bool utils::string::contains(std::wstring const& str, std::wstring::value_type c) {
@@ -248,10 +370,7 @@ bool utils::string::containsAll(std::wstring const& str, std::vector<std::wstrin
 }
 
 size_t utils::string::count(std::string const& str, char countC) {
-    size_t res = 0;
-    for (auto c : str)
-        if (c == countC) res++;
-    return res;
+    return countChar(str, countC);
 }
 
 size_t utils::string::count(std::wstring const& str, wchar_t countC) {
@@ -262,9 +381,7 @@ size_t utils::string::count(std::wstring const& str, wchar_t countC) {
 }
 
 std::string& utils::string::trimLeftIP(std::string& str) {
-    str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](auto ch) {
-                  return !std::isspace(ch);
-              }));
+    str.erase(0, str.size() - utils::string::trimLeftView(str).size());
     return str;
 }
 
@@ -276,16 +393,7 @@ std::wstring& utils::string::trimLeftIP(std::wstring& str) {
 }
 
 std::string& utils::string::trimRightIP(std::string& str) {
-    str.erase(
-        std::find_if(
-            str.rbegin(),
-            str.rend(),
-            [](auto ch) {
-                return !std::isspace(ch);
-            }
-        ).base(),
-        str.end()
-    );
+    str.erase(utils::string::trimRightView(str).size());
     return str;
 }
 
@@ -312,8 +420,7 @@ std::wstring& utils::string::trimIP(std::wstring& str) {
 }
 
 std::string utils::string::trimLeft(std::string const& str) {
-    auto s2 = str;
-    return utils::string::trimLeftIP(s2);
+    return std::string(utils::string::trimLeftView(str));
 }
 
 std::wstring utils::string::trimLeft(std::wstring const& str) {
@@ -322,8 +429,7 @@ std::wstring utils::string::trimLeft(std::wstring const& str) {
 }
 
 std::string utils::string::trimRight(std::string const& str) {
-    auto ret = str;
-    return utils::string::trimRightIP(ret);
+    return std::string(utils::string::trimRightView(str));
 }
 
 std::wstring utils::string::trimRight(std::wstring const& str) {
@@ -332,8 +438,7 @@ std::wstring utils::string::trimRight(std::wstring const& str) {
 }
 
 std::string utils::string::trim(std::string const& str) {
-    auto ret = str;
-    return utils::string::trimIP(ret);
+    return std::string(utils::string::trimView(str));
 }
 
 std::wstring utils::string::trim(std::wstring const& str) {
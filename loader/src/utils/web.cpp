@@ -3,7 +3,10 @@
 #include <Geode/utils/casts.hpp>
 #include <Geode/utils/web.hpp>
 #include <matjson.hpp>
+#include <atomic>
+#include <chrono>
 #include <thread>
+#include "WebEngine.hpp"
 
 using namespace geode::prelude;
 using namespace web;
@@ -24,15 +27,28 @@ namespace geode::utils::fetch {
         return size * nmemb;
     }
 
+    // Progress of a blocking download. curl reports it on the engine thread,
+    // and the thread waiting for the download hands it to the callback
+    struct FileProgress {
+        std::atomic<double> now = 0.0;
+        std::atomic<double> total = 0.0;
+        std::atomic_bool changed = false;
+        std::atomic_bool cancelled = false;
+    };
+
     static int progress(void* ptr, double total, double now, double, double) {
-        return (*as<web::FileProgressCallback*>(ptr))(now, total) != true;
+        auto prog = as<FileProgress*>(ptr);
+        prog->now = now;
+        prog->total = total;
+        prog->changed = true;
+        return prog->cancelled;
     }
 }
 
 Result<> web::fetchFile(
     std::string const& url, ghc::filesystem::path const& into, FileProgressCallback prog
 ) {
-    auto curl = curl_easy_init();
+    auto curl = WebEngine::get()->createHandle();
 
     if (!curl) return Err("Curl not initialized!");
 
@@ -48,29 +64,37 @@ Result<> web::fetchFile(
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &file);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
+    utils::fetch::FileProgress progress;
+    utils::MiniFunction<void()> poll;
     if (prog) {
         curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0);
         curl_easy_setopt(curl, CURLOPT_PROGRESSFUNCTION, utils::fetch::progress);
-        curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &prog);
+        curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &progress);
+        poll = [&]() {
+            if (!progress.changed.exchange(false) || progress.cancelled) return;
+            if (!prog(progress.now, progress.total)) {
+                progress.cancelled = true;
+            }
+        };
     }
-    auto res = curl_easy_perform(curl);
+    auto res = WebEngine::get()->perform(curl, 0, std::move(poll));
     if (res != CURLE_OK) {
-        curl_easy_cleanup(curl);
+        WebEngine::get()->releaseHandle(curl);
         return Err("Fetch failed: " + std::string(curl_easy_strerror(res)));
     }
 
     char* ct;
     res = curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &ct);
     if ((res == CURLE_OK) && ct) {
-        curl_easy_cleanup(curl);
+        WebEngine::get()->releaseHandle(curl);
         return Ok();
     }
-    curl_easy_cleanup(curl);
+    WebEngine::get()->releaseHandle(curl);
     return Err("Error getting info: " + std::string(curl_easy_strerror(res)));
 }
 
 Result<ByteVector> web::fetchBytes(std::string const& url) {
-    auto curl = curl_easy_init();
+    auto curl = WebEngine::get()->createHandle();
 
     if (!curl) return Err("Curl not initialized!");
 
@@ -81,19 +105,19 @@ Result<ByteVector> web::fetchBytes(std::string const& url) {
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret);
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBytes);
-    auto res = curl_easy_perform(curl);
+    auto res = WebEngine::get()->perform(curl);
     if (res != CURLE_OK) {
-        curl_easy_cleanup(curl);
+        WebEngine::get()->releaseHandle(curl);
         return Err("Fetch failed");
     }
 
     char* ct;
     res = curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &ct);
     if ((res == CURLE_OK) && ct) {
-        curl_easy_cleanup(curl);
+        WebEngine::get()->releaseHandle(curl);
         return Ok(ret);
     }
-    curl_easy_cleanup(curl);
+    WebEngine::get()->releaseHandle(curl);
     return Err("Error getting info: " + std::string(curl_easy_strerror(res)));
 }
 
@@ -109,7 +133,7 @@ Result<matjson::Value> web::fetchJSON(std::string const& url) {
 }
 
 Result<std::string> web::fetch(std::string const& url) {
-    auto curl = curl_easy_init();
+    auto curl = WebEngine::get()->createHandle();
 
     if (!curl) return Err("Curl not initialized!");
 
@@ -120,19 +144,19 @@ Result<std::string> web::fetch(std::string const& url) {
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeString);
     curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
-    auto res = curl_easy_perform(curl);
+    auto res = WebEngine::get()->perform(curl);
     if (res != CURLE_OK) {
-        curl_easy_cleanup(curl);
+        WebEngine::get()->releaseHandle(curl);
         return Err("Fetch failed");
     }
 
     char* ct;
     res = curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &ct);
     if ((res == CURLE_OK) && ct) {
-        curl_easy_cleanup(curl);
+        WebEngine::get()->releaseHandle(curl);
         return Ok(ret);
     }
-    curl_easy_cleanup(curl);
+    WebEngine::get()->releaseHandle(curl);
     return Err("Error getting info: " + std::string(curl_easy_strerror(res)));
 }
 
@@ -157,8 +181,6 @@ private:
     std::atomic<bool> m_cancelled = false;
     std::atomic<bool> m_finished = false;
     std::atomic<bool> m_cleanedUp = false;
-    std::condition_variable m_statusCV;
-    std::mutex m_statusMutex;
     SentAsyncWebRequest* m_self;
 
     mutable std::mutex m_mutex;
@@ -171,6 +193,30 @@ private:
     std::variant<std::monostate, std::ostream*, ghc::filesystem::path> m_target;
     std::vector<std::string> m_httpHeaders;
 
+    // transfer state, owned by the request while the web engine runs it
+    CURL* m_curl = nullptr;
+    curl_slist* m_headerList = nullptr;
+    // resulting byte array
+    ByteVector m_data;
+    // output file if downloading to file. unique_ptr because not always
+    // initialized but don't wanna manually managed memory
+    std::unique_ptr<std::ofstream> m_file = nullptr;
+    AsyncData m_received;
+    bool m_resumable = false;
+    int m_priority = 0;
+    // how much of the target file was already downloaded
+    uint64_t m_resumeFrom = 0;
+    // offset of the next chunk of the body passed to m_received
+    uint64_t m_receivedOffset = 0;
+
+    // latest progress reported by curl. the main thread reads it at most
+    // once per frame, with only a single delivery queued at a time
+    std::atomic<double> m_progressNow = 0.0;
+    std::atomic<double> m_progressTotal = 0.0;
+    std::atomic<bool> m_progressQueued = false;
+    // last progress handed to the main thread, only touched by the engine
+    double m_deliveredNow = -1.0;
+    std::chrono::steady_clock::time_point m_deliveredAt;
 
     template <class T>
     friend class AsyncWebResult;
@@ -180,6 +226,11 @@ private:
     void resume();
     void error(std::string const& error, int code);
     void doCancel();
+    void finish(CURLcode res);
+    size_t write(char const* data, size_t size);
+    void openTargetFile(bool resume);
+    void updateProgress(double now, double total);
+    void deliverProgress();
 
 public:
     Impl(SentAsyncWebRequest* self, AsyncWebRequest const&, std::string const& id);
@@ -212,6 +263,9 @@ public:
     std::variant<std::monostate, std::ostream*, ghc::filesystem::path> m_target;
     std::vector<std::string> m_httpHeaders;
     std::chrono::seconds m_timeoutSeconds;
+    int m_priority = 0;
+    AsyncData m_received = nullptr;
+    bool m_resumable = false;
 
     SentAsyncWebRequestHandle send(AsyncWebRequest&);
 };
@@ -230,19 +284,10 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
     m_postFields(req.m_impl->m_postFields),
     m_isJsonRequest(req.m_impl->m_isJsonRequest),
     m_sent(req.m_impl->m_sent),
-    m_httpHeaders(req.m_impl->m_httpHeaders) {
-
-#define AWAIT_RESUME()    \
-    {\
-        auto lock = std::unique_lock(m_statusMutex);\
-        m_statusCV.wait(lock, [this]() { \
-            return !m_paused; \
-        });\
-        if (m_cancelled) {\
-            this->doCancel();\
-            return;\
-        }\
-    }\
+    m_httpHeaders(req.m_impl->m_httpHeaders),
+    m_received(req.m_impl->m_received),
+    m_resumable(req.m_impl->m_resumable),
+    m_priority(req.m_impl->m_priority) {
 
     if (req.m_impl->m_then) m_thens.push_back(req.m_impl->m_then);
     if (req.m_impl->m_progress) m_progresses.push_back(req.m_impl->m_progress);
@@ -251,186 +296,260 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
 
     auto timeoutSeconds = req.m_impl->m_timeoutSeconds;
 
-    std::thread([this, timeoutSeconds]() {
-        thread::setName("Curl Request");
+    m_curl = WebEngine::get()->createHandle();
+    if (!m_curl) {
+        this->error("Curl not initialized", -1);
+        return;
+    }
+    auto curl = m_curl;
 
-        AWAIT_RESUME();
+    if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
+        this->openTargetFile(m_resumable);
+    }
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, this);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char* data, size_t size, size_t nmemb, void* ptr) {
+        return static_cast<SentAsyncWebRequest::Impl*>(ptr)->write(data, size * nmemb);
+    });
+    curl_easy_setopt(curl, CURLOPT_URL, m_url.c_str());
+    // No need to verify SSL, we trust our domains :-)
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
+    // User Agent
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, m_userAgent.c_str());
 
-        auto curl = curl_easy_init();
-        if (!curl) {
-            return this->error("Curl not initialized", -1);
-        }
+    // Headers
+    for (auto& header : m_httpHeaders) {
+        m_headerList = curl_slist_append(m_headerList, header.c_str());
+    }
 
-        // resulting byte array
-        ByteVector ret;
-        // output file if downloading to file. unique_ptr because not always
-        // initialized but don't wanna manually managed memory
-        std::unique_ptr<std::ofstream> file = nullptr;
-
-        // into file
-        if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
-            file = std::make_unique<std::ofstream>(
-                std::get<ghc::filesystem::path>(m_target), std::ios::out | std::ios::binary
-            );
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, file.get());
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
-        }
-        // into stream
-        else if (std::holds_alternative<std::ostream*>(m_target)) {
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, std::get<std::ostream*>(m_target));
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
+    // Post request
+    if (m_isPostRequest || m_customRequest.size()) {
+        if (m_isPostRequest) {
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
         }
-        // into memory
         else {
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret);
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBytes);
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, m_customRequest.c_str());
         }
-        curl_easy_setopt(curl, CURLOPT_URL, m_url.c_str());
-        // No need to verify SSL, we trust our domains :-)
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
-        // User Agent
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, m_userAgent.c_str());
-
-        // Headers
-        curl_slist* headers = nullptr;
-        for (auto& header : m_httpHeaders) {
-            headers = curl_slist_append(headers, header.c_str());
+        if (m_isJsonRequest) {
+            m_headerList = curl_slist_append(m_headerList, "Content-Type: application/json");
         }
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, m_postFields.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, m_postFields.size());
+    }
 
-        // Post request
-        if (m_isPostRequest || m_customRequest.size()) {
-            if (m_isPostRequest) {
-                curl_easy_setopt(curl, CURLOPT_POST, 1L);
-            }
-            else {
-                curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, m_customRequest.c_str());
-            }
-            if (m_isJsonRequest) {
-                headers = curl_slist_append(headers, "Content-Type: application/json");
+    // Timeout
+    if (timeoutSeconds.count()) {
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeoutSeconds.count());
+    }
+
+    // Track progress
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0);
+    // Follow redirects
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
+    // Fail if response code is 4XX or 5XX
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L); // we will handle http errors manually
+
+    // Headers end
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, m_headerList);
+
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, this);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, (+[](char* buffer, size_t size, size_t nitems, void* ptr){
+        auto self = static_cast<SentAsyncWebRequest::Impl*>(ptr);
+        std::string line;
+        std::stringstream ss(std::string(buffer, size * nitems));
+        while (std::getline(ss, line)) {
+            auto colon = line.find(':');
+            if (colon == std::string::npos) continue;
+            auto key = line.substr(0, colon);
+            auto value = line.substr(colon + 2);
+            if (value.ends_with('\r')) {
+                value = value.substr(0, value.size() - 1);
             }
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, m_postFields.c_str());
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, m_postFields.size());
+            self->m_responseHeader[key] = value;
         }
+        return size * nitems;
+    }));
+
+    // the engine drives every request from a single thread, so this must
+    // never block
+    curl_easy_setopt(
+        curl,
+        CURLOPT_PROGRESSFUNCTION,
+        +[](void* ptr, double total, double now, double, double) -> int {
+            auto self = static_cast<SentAsyncWebRequest::Impl*>(ptr);
+            if (self->m_cancelled) {
+                if (self->m_file) {
+                    self->m_file->close();
+                }
+                return 1;
+            }
 
-        // Timeout
-        if (timeoutSeconds.count()) {
-            curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeoutSeconds.count());
+            self->updateProgress(now, total);
+            return 0;
         }
+    );
+    curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, this);
 
-        // Track progress
-        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0);
-        // Follow redirects
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
-        // Fail if response code is 4XX or 5XX
-        curl_easy_setopt(curl, CURLOPT_FAILONERROR, 0L); // we will handle http errors manually
-
-        // Headers end
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-
-        struct ProgressData {
-            SentAsyncWebRequest::Impl* self;
-            std::ofstream* file;
-        } data{this, file.get()};
-
-        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &data);
-        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, (+[](char* buffer, size_t size, size_t nitems, void* ptr){
-            auto data = static_cast<ProgressData*>(ptr);
-            std::unordered_map<std::string, std::string> headers;
-            std::string line;
-            std::stringstream ss(std::string(buffer, size * nitems));
-            while (std::getline(ss, line)) {
-                auto colon = line.find(':');
-                if (colon == std::string::npos) continue;
-                auto key = line.substr(0, colon);
-                auto value = line.substr(colon + 2);
-                if (value.ends_with('\r')) {
-                    value = value.substr(0, value.size() - 1);
-                }
-                data->self->m_responseHeader[key] = value;
-            }
-            return size * nitems;
-        }));
-
-        curl_easy_setopt(
-            curl,
-            CURLOPT_PROGRESSFUNCTION,
-            +[](void* ptr, double total, double now, double, double) -> int {
-                auto data = static_cast<ProgressData*>(ptr);
-                auto lock = std::unique_lock(data->self->m_statusMutex);
-                data->self->m_statusCV.wait(lock, [data]() {
-                    return !data->self->m_paused;
-                });
-                if (data->self->m_cancelled) {
-                    if (data->file) {
-                        data->file->close();
-                    }
-                    return 1;
-                }
+    WebEngine::get()->enqueue(m_curl, m_priority, [this](CURLcode res) {
+        this->finish(res);
+    });
+}
 
-                Loader::get()->queueInMainThread([self = data->self, now, total]() {
-                    std::unique_lock<std::mutex> l(self->m_mutex);
-                    for (auto& prog : self->m_progresses) {
-                        l.unlock();
-                        prog(*self->m_self, now, total);
-                        l.lock();
-                    }
-                });
-                return 0;
-            }
-        );
-        curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &data);
-        auto res = curl_easy_perform(curl);
-
-        // free the header list
-        curl_slist_free_all(headers);
-
-        long code = 0;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
-        if (res != CURLE_OK) {
-            curl_easy_cleanup(curl);
-            if (m_cancelled) {
-                return this->doCancel();
-            } else {
-                return this->error("Fetch failed: " + std::string(curl_easy_strerror(res)), code);
-            }
+void SentAsyncWebRequest::Impl::openTargetFile(bool resume) {
+    auto& path = std::get<ghc::filesystem::path>(m_target);
+    m_resumeFrom = 0;
+    if (resume) {
+        std::error_code ec;
+        auto size = ghc::filesystem::file_size(path, ec);
+        if (!ec) {
+            m_resumeFrom = size;
         }
-        if (code >= 400 && code < 600) {
-            std::string response_str(ret.begin(), ret.end());
-            curl_easy_cleanup(curl);
-            return this->error(response_str, code);
+    }
+    m_file = std::make_unique<std::ofstream>(
+        path, std::ios::out | std::ios::binary | (m_resumeFrom ? std::ios::app : std::ios::trunc)
+    );
+    curl_easy_setopt(m_curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(m_resumeFrom));
+    m_receivedOffset = 0;
+}
+
+size_t SentAsyncWebRequest::Impl::write(char const* data, size_t size) {
+    // error pages end up in the error message instead of the target
+    long code = 0;
+    curl_easy_getinfo(m_curl, CURLINFO_RESPONSE_CODE, &code);
+    if (code >= 400 || std::holds_alternative<std::monostate>(m_target)) {
+        m_data.insert(m_data.end(), data, data + size);
+        if (code >= 400) return size;
+    }
+    else if (m_file) {
+        m_file->write(data, size);
+    }
+    else if (std::holds_alternative<std::ostream*>(m_target)) {
+        std::get<std::ostream*>(m_target)->write(data, size);
+    }
+
+    if (m_received) {
+        // hand over the part downloaded before resuming first
+        if (m_receivedOffset < m_resumeFrom) {
+            std::ifstream existing(std::get<ghc::filesystem::path>(m_target), std::ios::binary);
+            std::vector<char> buffer(64 * 1024);
+            while (m_receivedOffset < m_resumeFrom && existing) {
+                auto amount = std::min<uint64_t>(buffer.size(), m_resumeFrom - m_receivedOffset);
+                existing.read(buffer.data(), amount);
+                auto read = static_cast<size_t>(existing.gcount());
+                if (!read) break;
+                m_received(m_receivedOffset, reinterpret_cast<uint8_t const*>(buffer.data()), read);
+                m_receivedOffset += read;
+            }
+            m_receivedOffset = m_resumeFrom;
         }
-        curl_easy_cleanup(curl);
+        m_received(m_receivedOffset, reinterpret_cast<uint8_t const*>(data), size);
+    }
+    m_receivedOffset += size;
+    return size;
+}
+
+// don't bother the main thread more often than this, unless the
+// progress has moved noticeably
+static constexpr auto PROGRESS_INTERVAL = std::chrono::milliseconds(100);
+static constexpr double PROGRESS_MIN_STEP = 0.01;
+
+void SentAsyncWebRequest::Impl::updateProgress(double now, double total) {
+    m_progressNow = now;
+    m_progressTotal = total;
+
+    if (now == m_deliveredNow) return;
+    auto time = std::chrono::steady_clock::now();
+    bool done = total > 0 && now >= total;
+    bool stepped = total > 0 && (now - m_deliveredNow) / total >= PROGRESS_MIN_STEP;
+    if (!done && !stepped && time - m_deliveredAt < PROGRESS_INTERVAL) return;
+
+    // a delivery is already waiting for the next frame; it will pick up
+    // the values stored above
+    if (m_progressQueued.exchange(true)) return;
+    m_deliveredNow = now;
+    m_deliveredAt = time;
+    Loader::get()->queueInMainThread([this]() {
+        this->deliverProgress();
+    });
+}
 
-        AWAIT_RESUME();
+void SentAsyncWebRequest::Impl::deliverProgress() {
+    m_progressQueued = false;
+    auto now = m_progressNow.load();
+    auto total = m_progressTotal.load();
+    std::unique_lock<std::mutex> l(m_mutex);
+    for (auto& prog : m_progresses) {
+        l.unlock();
+        prog(*m_self, now, total);
+        l.lock();
+    }
+}
 
-        // if something is still holding a handle to this
-        // request, then they may still cancel it
-        m_finished = true;
+void SentAsyncWebRequest::Impl::finish(CURLcode res) {
+    long code = 0;
+    curl_easy_getinfo(m_curl, CURLINFO_RESPONSE_CODE, &code);
 
-        Loader::get()->queueInMainThread([this, ret]() {
-            std::unique_lock<std::mutex> l(m_mutex);
-            for (auto& then : m_thens) {
-                l.unlock();
-                then(*m_self, ret);
-                l.lock();
-            }
-            // Delay the destruction of SentAsyncWebRequest till the next frame
-            // otherwise we'd have an use-after-free
-            Loader::get()->queueInMainThread([m_id = m_id] {
-                std::lock_guard __(RUNNING_REQUESTS_MUTEX);
-                RUNNING_REQUESTS.erase(m_id);
-            });
+    // the server can't continue from where the file left off, so start over
+    if (m_resumeFrom && !m_cancelled && (res == CURLE_RANGE_ERROR || code == 416)) {
+        log::debug("Unable to resume download of {}, restarting it", m_url);
+        m_file.reset();
+        m_data.clear();
+        this->openTargetFile(false);
+        WebEngine::get()->enqueue(m_curl, m_priority, [this](CURLcode res) {
+            this->finish(res);
+        });
+        return;
+    }
+
+    // free the header list
+    curl_slist_free_all(m_headerList);
+    m_headerList = nullptr;
+
+    WebEngine::get()->releaseHandle(m_curl);
+    m_curl = nullptr;
+
+    if (m_file) {
+        m_file->close();
+    }
+
+    if (res != CURLE_OK) {
+        if (m_cancelled) {
+            return this->doCancel();
+        } else {
+            return this->error("Fetch failed: " + std::string(curl_easy_strerror(res)), code);
+        }
+    }
+    if (code >= 400 && code < 600) {
+        std::string response_str(m_data.begin(), m_data.end());
+        return this->error(response_str, code);
+    }
+
+    // if something is still holding a handle to this
+    // request, then they may still cancel it
+    m_finished = true;
+
+    Loader::get()->queueInMainThread([this, ret = std::move(m_data)]() {
+        std::unique_lock<std::mutex> l(m_mutex);
+        for (auto& then : m_thens) {
+            l.unlock();
+            then(*m_self, ret);
+            l.lock();
+        }
+        // Delay the destruction of SentAsyncWebRequest till the next frame
+        // otherwise we'd have an use-after-free
+        Loader::get()->queueInMainThread([m_id = m_id] {
+            std::lock_guard __(RUNNING_REQUESTS_MUTEX);
+            RUNNING_REQUESTS.erase(m_id);
         });
-    }).detach();
+    });
 }
 
 void SentAsyncWebRequest::Impl::doCancel() {
     if (m_cleanedUp) return;
     m_cleanedUp = true;
 
-    // remove file if downloaded to one
-    if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
+    // remove file if downloaded to one, unless it can be picked up later
+    if (std::holds_alternative<ghc::filesystem::path>(m_target) && !m_resumable) {
         auto path = std::get<ghc::filesystem::path>(m_target);
         if (ghc::filesystem::exists(path)) {
             std::error_code ec;
@@ -456,14 +575,14 @@ void SentAsyncWebRequest::Impl::cancel() {
     }
 }
 
+// callbacks are only ever invoked on the main thread under m_mutex, so
+// pausing no longer has to hold up the transfer itself
 void SentAsyncWebRequest::Impl::pause() {
     m_paused = true;
-    m_statusCV.notify_all();
 }
 
 void SentAsyncWebRequest::Impl::resume() {
     m_paused = false;
-    m_statusCV.notify_all();
 }
 
 bool SentAsyncWebRequest::Impl::finished() const {
@@ -471,10 +590,6 @@ bool SentAsyncWebRequest::Impl::finished() const {
 }
 
 void SentAsyncWebRequest::Impl::error(std::string const& error, int code) {
-    auto lock = std::unique_lock(m_statusMutex);
-    m_statusCV.wait(lock, [this]() {
-        return !m_paused;
-    });
     Loader::get()->queueInMainThread([this, error, code]() {
         {
             std::unique_lock<std::mutex> l(m_mutex);
@@ -577,6 +692,16 @@ AsyncWebRequest& AsyncWebRequest::timeout(std::chrono::seconds seconds) {
     return *this;
 }
 
+AsyncWebRequest& AsyncWebRequest::priority(int priority) {
+    m_impl->m_priority = priority;
+    return *this;
+}
+
+AsyncWebRequest& AsyncWebRequest::resumable() {
+    m_impl->m_resumable = true;
+    return *this;
+}
+
 AsyncWebRequest& AsyncWebRequest::header(std::string_view const header) {
     std::string str(header);
     // remove \r and \n
@@ -638,6 +763,11 @@ AsyncWebRequest& AsyncWebRequest::cancelled(AsyncCancelled cancelledFunc) {
     return *this;
 }
 
+AsyncWebRequest& AsyncWebRequest::received(AsyncData receivedFunc) {
+    m_impl->m_received = receivedFunc;
+    return *this;
+}
+
 SentAsyncWebRequestHandle AsyncWebRequest::send() {
     return m_impl->send(*this);
 }